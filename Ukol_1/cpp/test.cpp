@@ -1,4 +1,7 @@
 #include "gtest/gtest.h"
+#include <array>
+#include <deque>
+#include <sstream>
 #include "vypocty.cpp" // Předpokládám, že kód je v souboru vypocty.cpp
 
 TEST(TestyFunkci, Soucet)
@@ -63,3 +66,431 @@ TEST(TestyFunkci, Median)
     cisla = {}; // Prázdný seznam - zde by mohla funkce házet výjimku
     // EXPECT_THROW(median(cisla), std::exception); // Otestuj, zda je vyhozena výjimka
 }
+
+TEST(TestyFunkci, MedianSudyPocet)
+{
+    std::vector<int> cisla = {4, 1, 3, 2};
+    EXPECT_EQ(median(cisla), 2.5);
+
+    cisla = {2147483647, 2147483647}; // Součet prostředních prvků by v int přetekl
+    EXPECT_EQ(median(cisla), 2147483647.0);
+}
+
+TEST(TestyFunkci, Statistiky)
+{
+    std::vector<int> cisla = {1, 2, 3, 6, 6, 6, 8};
+    Statistiky s = statistiky(cisla);
+    EXPECT_EQ(s.soucet, 32);
+    EXPECT_EQ(s.soucin, 10368);
+    EXPECT_NEAR(s.prumer, 4.571, 0.001);
+    EXPECT_EQ(s.median, 6);
+
+    cisla = {8, -3, 5, 0, 12, 7};
+    s = statistiky(cisla);
+    EXPECT_EQ(s.soucet, soucet(cisla));
+    EXPECT_EQ(s.soucin, soucin(cisla));
+    EXPECT_DOUBLE_EQ(s.prumer, prumer(cisla));
+    EXPECT_EQ(s.median, median(cisla));
+}
+
+TEST(TestyFunkci, PrubezneStatistiky)
+{
+    std::vector<int> cisla = {5, -2, 9, 9, 1, 7, 3, 0, 12, 4};
+    PrubezneStatistiky prubezne;
+    std::vector<int> doposud;
+    for (int c : cisla) {
+        prubezne.pridej(c);
+        doposud.push_back(c);
+        // Po každé hodnotě musí stav odpovídat výpočtu nad všemi dosavadními daty
+        EXPECT_EQ(prubezne.pocet(), doposud.size());
+        EXPECT_EQ(prubezne.soucet(), soucet(doposud));
+        EXPECT_DOUBLE_EQ(prubezne.prumer(), prumer(doposud));
+        EXPECT_EQ(prubezne.median(), median(doposud));
+    }
+
+    PrubezneStatistiky davkove;
+    davkove.pridej(std::vector<int>{1, 2, 3});
+    davkove.pridej(std::vector<int>{6, 6, 6, 8});
+    Statistiky s = davkove.vysledek();
+    EXPECT_EQ(s.soucet, 32);
+    EXPECT_EQ(s.soucin, 10368);
+    EXPECT_EQ(s.median, 6);
+}
+
+TEST(TestyFunkci, PrumerBezPreteceni)
+{
+    std::vector<int> cisla(1000, 2147483647);
+    EXPECT_EQ(prumer(cisla), 2147483647.0);
+    EXPECT_EQ(statistiky(cisla).prumer, 2147483647.0);
+}
+
+TEST(TestyFunkci, VektorovaJadra)
+{
+    // Všechna jádra, která procesor umí, musí dát stejné bity jako skalární cesta
+    std::vector<RedukceJadro> jadra;
+#ifdef VYPOCTY_X86_SIMD
+    if (__builtin_cpu_supports("sse4.2")) {
+        jadra.push_back(redukce_sse42<true, true>);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        jadra.push_back(redukce_avx2<true, true>);
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        jadra.push_back(redukce_avx512<true, true>);
+    }
+#endif
+
+    std::vector<int> cisla;
+    unsigned int stav = 12345;
+    for (int i = 0; i < 1037; i++) {
+        stav = stav * 1103515245u + 12345u;
+        cisla.push_back(static_cast<int>(stav)); // celý rozsah int včetně záporných
+    }
+
+    for (size_t n : {0, 1, 3, 15, 16, 17, 100, 1037}) {
+        Redukce ocekavano = redukce_skalar<true, true>(cisla.data(), n);
+        for (RedukceJadro jadro : jadra) {
+            Redukce r = jadro(cisla.data(), n);
+            EXPECT_EQ(r.soucet, ocekavano.soucet) << "n = " << n;
+            EXPECT_EQ(r.soucin, ocekavano.soucin) << "n = " << n;
+        }
+    }
+}
+
+TEST(TestyFunkci, ParsujCisla)
+{
+    std::string vstup = "1,2, 3 ,-6,,+6,abc,6\n8,99999999999,7x";
+    std::vector<int> cisla;
+    std::vector<ChybaParsovani> chyby;
+    EXPECT_EQ(parsuj_cisla(vstup.data(), vstup.size(), cisla, chyby), 7u);
+    EXPECT_EQ(cisla, (std::vector<int>{1, 2, 3, -6, 6, 6, 8}));
+
+    // Chyby nesou bajtovou pozici začátku tokenu
+    ASSERT_EQ(chyby.size(), 3u);
+    EXPECT_EQ(chyby[0].token, "abc");
+    EXPECT_EQ(chyby[0].pozice, vstup.find("abc"));
+    EXPECT_EQ(chyby[1].token, "99999999999");
+    EXPECT_EQ(chyby[1].pozice, vstup.find("999"));
+    EXPECT_EQ(chyby[2].token, "7x");
+    EXPECT_EQ(chyby[2].pozice, vstup.find("7x"));
+}
+
+TEST(TestyFunkci, NactiCislaZProudu)
+{
+    // Dost dlouhý vstup, aby se pole lámala přes hranice bloků
+    std::string vstup;
+    std::vector<int> ocekavano;
+    for (int i = 0; i < 300000; i++) {
+        int hodnota = (i % 7 == 0) ? -i : i * 13;
+        vstup += std::to_string(hodnota) + ",";
+        ocekavano.push_back(hodnota);
+    }
+    vstup += "chyba";
+
+    std::istringstream ss(vstup);
+    std::vector<int> cisla;
+    std::vector<ChybaParsovani> chyby;
+    nacti_cisla_z_proudu(ss, cisla, chyby);
+    EXPECT_EQ(cisla, ocekavano);
+    ASSERT_EQ(chyby.size(), 1u);
+    EXPECT_EQ(chyby[0].pozice, vstup.size() - 5);
+
+    // Stejný obsah ze souboru (přes mmap)
+    const char *jmeno = "test_cisla.csv";
+    {
+        std::ofstream ofs(jmeno, std::ios::binary);
+        ofs << vstup;
+    }
+    std::vector<int> ze_souboru;
+    chyby.clear();
+    ASSERT_TRUE(nacti_cisla_ze_souboru(jmeno, ze_souboru, chyby));
+    EXPECT_EQ(ze_souboru, ocekavano);
+    EXPECT_EQ(chyby.size(), 1u);
+    std::remove(jmeno);
+
+    EXPECT_FALSE(nacti_cisla_ze_souboru("neexistujici_soubor.csv", ze_souboru, chyby));
+}
+
+TEST(TestyFunkci, ParalelniVypocty)
+{
+    NastaveniParalelismu nastaveni;
+    nastaveni.vlakna = 4;
+    nastaveni.prah = 0; // i malé vstupy paralelně
+
+    unsigned int stav = 7;
+    for (size_t n : {1, 2, 4097, 20000, 100001}) {
+        std::vector<int> cisla(n);
+        std::vector<int> opakovane(n);
+        for (size_t i = 0; i < n; i++) {
+            stav = stav * 1103515245u + 12345u;
+            cisla[i] = static_cast<int>(stav >> 8) - (1 << 23);
+            opakovane[i] = static_cast<int>(stav % 5); // hodně stejných hodnot
+        }
+        for (const std::vector<int> &data : {cisla, opakovane}) {
+            EXPECT_EQ(soucet_paralelne(data, nastaveni), soucet(data)) << "n = " << n;
+            EXPECT_EQ(soucin_paralelne(data, nastaveni), soucin(data)) << "n = " << n;
+            EXPECT_DOUBLE_EQ(prumer_paralelne(data, nastaveni), prumer(data)) << "n = " << n;
+            EXPECT_EQ(median_paralelne(data, nastaveni), median(data)) << "n = " << n;
+        }
+    }
+}
+
+TEST(TestyFunkci, ObecneTypy)
+{
+    std::vector<long long> velka = {4000000000LL, 5000000000LL, -1LL};
+    EXPECT_EQ(soucet(std::span(velka)), 8999999999LL);
+    EXPECT_DOUBLE_EQ(prumer(std::span(velka)), 8999999999.0 / 3);
+    EXPECT_EQ(median(std::span(velka)), 4000000000.0);
+
+    std::vector<float> realna = {0.5f, 1.5f, 2.0f, 4.0f};
+    EXPECT_DOUBLE_EQ(soucet(std::span(realna)), 8.0);
+    EXPECT_DOUBLE_EQ(soucin(std::span(realna)), 6.0);
+    EXPECT_DOUBLE_EQ(median(std::span(realna)), 1.75);
+
+    // uint16_t se sčítá v 64 bitech, takže nepřeteče
+    std::vector<uint16_t> kratka(1000, 65535);
+    EXPECT_EQ(soucet(std::span(kratka)), 65535000ULL);
+
+    // Výřez z většího pole a rozsah iterátorů nad nesouvislým kontejnerem
+    std::vector<int> cisla = {100, 1, 2, 3, 6, 6, 6, 8, 100};
+    std::span<const int> vyrez(cisla.data() + 1, 7);
+    EXPECT_EQ(soucet(vyrez), 32);
+    EXPECT_EQ(soucin(vyrez), 10368);
+    EXPECT_EQ(median(vyrez), 6);
+    std::deque<short> fronta = {3, 1, 2};
+    EXPECT_EQ(soucet(fronta.begin(), fronta.end()), 6);
+    EXPECT_EQ(median(fronta.begin(), fronta.end()), 2);
+}
+
+TEST(TestyFunkci, ConstexprTabulka)
+{
+    static constexpr std::array<int, 7> tabulka = {1, 2, 3, 6, 6, 6, 8};
+    static_assert(soucet(std::span(tabulka)) == 32);
+    static_assert(soucin(std::span(tabulka)) == 10368);
+    static_assert(median(std::span(tabulka)) == 6);
+    static_assert(prumer(std::span(tabulka)) > 4.57 && prumer(std::span(tabulka)) < 4.58);
+}
+
+TEST(TestyFunkci, TridiciSite)
+{
+    // Princip 0-1: síť třídí všechny vstupy, právě když třídí všechny vstupy z nul a jedniček
+    for (size_t n = 2; n <= NEJVETSI_SIT; n++) {
+        for (unsigned int bity = 0; bity < (1u << n); bity++) {
+            int data[NEJVETSI_SIT];
+            for (size_t i = 0; i < n; i++) {
+                data[i] = (bity >> i) & 1;
+            }
+            serad_siti(data, n);
+            EXPECT_TRUE(std::is_sorted(data, data + n)) << "n = " << n << ", bity = " << bity;
+        }
+    }
+}
+
+TEST(TestyFunkci, DavkoveStatistiky)
+{
+    std::vector<int> hodnoty;
+    std::vector<size_t> offsety = {0};
+    unsigned int stav = 99;
+    for (size_t rada = 0; rada < 500; rada++) {
+        size_t delka = rada % 23; // včetně prázdných řad i řad delších než síť
+        for (size_t j = 0; j < delka; j++) {
+            stav = stav * 1103515245u + 12345u;
+            hodnoty.push_back(static_cast<int>(stav % 2001) - 1000);
+        }
+        offsety.push_back(hodnoty.size());
+    }
+
+    NastaveniParalelismu nastaveni;
+    nastaveni.vlakna = 3;
+    nastaveni.prah = 0;
+    DavkoveStatistiky vysledek = davkove_statistiky(hodnoty, offsety, nastaveni);
+    ASSERT_EQ(vysledek.soucty.size(), 500u);
+    for (size_t i = 0; i < 500; i++) {
+        std::vector<int> rada(hodnoty.begin() + offsety[i], hodnoty.begin() + offsety[i + 1]);
+        EXPECT_EQ(vysledek.soucty[i], soucet(rada));
+        if (rada.empty()) {
+            EXPECT_TRUE(std::isnan(vysledek.prumery[i]));
+            EXPECT_TRUE(std::isnan(vysledek.mediany[i]));
+        } else {
+            EXPECT_DOUBLE_EQ(vysledek.prumery[i], prumer(rada));
+            EXPECT_EQ(vysledek.mediany[i], median(rada));
+        }
+    }
+
+    std::vector<size_t> spatne = {0, 5, 3};
+    EXPECT_THROW(davkove_statistiky(hodnoty, spatne), std::invalid_argument);
+}
+
+TEST(TestyFunkci, SerazenyPohled)
+{
+    std::vector<int> cisla = {8, 1, 6, 3, 6, 2, 6};
+    SerazenyPohled pohled(cisla);
+    EXPECT_EQ(pohled.median(), median(cisla));
+    EXPECT_EQ(pohled.kvantil(0.0), 1);
+    EXPECT_EQ(pohled.kvantil(1.0), 8);
+    EXPECT_DOUBLE_EQ(pohled.kvantil(0.25), 2.5);
+    EXPECT_EQ(pohled.pocet_mensich(6), 3u);
+    EXPECT_EQ(pohled.pocet_nejvyse(6), 6u);
+    EXPECT_EQ(pohled.pocet_mensich(0), 0u);
+    EXPECT_EQ(pohled.pocet_nejvyse(100), 7u);
+    EXPECT_THROW(pohled.kvantil(1.5), std::invalid_argument);
+
+    // Po přidání dávky i jednotlivé hodnoty odpovídá pohled datům setříděným znovu
+    std::vector<int> davka = {5, -4, 9, 6};
+    pohled.pridej(davka);
+    pohled.pridej(0);
+    cisla.insert(cisla.end(), davka.begin(), davka.end());
+    cisla.push_back(0);
+    std::vector<int> serazena = cisla;
+    std::sort(serazena.begin(), serazena.end());
+    EXPECT_EQ(pohled.data(), serazena);
+    EXPECT_EQ(pohled.median(), median(cisla));
+
+    SerazenyPohled prazdny;
+    EXPECT_TRUE(std::isnan(prazdny.median()));
+}
+
+TEST(TestyFunkci, KlouzaveOkno)
+{
+    std::vector<int> cisla;
+    unsigned int stav = 3;
+    for (int i = 0; i < 300; i++) {
+        stav = stav * 1103515245u + 12345u;
+        cisla.push_back(static_cast<int>(stav % 21) - 10); // hodně opakovaných hodnot
+    }
+
+    for (size_t sirka : {1, 2, 5, 16}) {
+        DavkoveStatistiky vysledek = klouzave_statistiky(cisla, sirka);
+        ASSERT_EQ(vysledek.soucty.size(), cisla.size() - sirka + 1);
+        for (size_t i = 0; i + sirka <= cisla.size(); i++) {
+            std::vector<int> okno(cisla.begin() + i, cisla.begin() + i + sirka);
+            EXPECT_EQ(vysledek.soucty[i], soucet(okno));
+            EXPECT_DOUBLE_EQ(vysledek.prumery[i], prumer(okno));
+            EXPECT_EQ(vysledek.mediany[i], median(okno)) << "sirka = " << sirka << ", i = " << i;
+        }
+    }
+
+    // Dokud se okno nenaplní, počítá se z hodnot, které už přišly
+    KlouzaveOkno okno(3);
+    okno.pridej(4);
+    okno.pridej(1);
+    EXPECT_FALSE(okno.plne());
+    EXPECT_EQ(okno.median(), 2.5);
+    okno.pridej(9);
+    okno.pridej(7);
+    EXPECT_TRUE(okno.plne());
+    EXPECT_EQ(okno.soucet(), 17);
+    EXPECT_EQ(okno.median(), 7);
+
+    EXPECT_TRUE(klouzave_statistiky(cisla, 301).soucty.empty());
+    EXPECT_THROW(KlouzaveOkno(0), std::invalid_argument);
+}
+
+TEST(TestyFunkci, KvantilovyNacrt)
+{
+    std::vector<int> cisla;
+    unsigned int stav = 17;
+    for (int i = 0; i < 200000; i++) {
+        stav = stav * 1103515245u + 12345u;
+        cisla.push_back(static_cast<int>(stav >> 4) % 1000000);
+    }
+    SerazenyPohled presne(cisla);
+
+    NastaveniParalelismu nastaveni;
+    nastaveni.vlakna = 4;
+    nastaveni.prah = 0;
+    KvantilovyNacrt nacrt = KvantilovyNacrt::z_dat(cisla, 200, nastaveni);
+    EXPECT_EQ(nacrt.pocet(), cisla.size());
+    EXPECT_EQ(nacrt.soucet(), soucet(std::span<const int>(cisla)));
+    EXPECT_DOUBLE_EQ(nacrt.prumer(), prumer(cisla));
+    EXPECT_LT(nacrt.velikost(), 1000u);
+
+    // Čtyři stejné úseky nesmí dát čtyři stejné náčrty - každý úsek má vlastní semeno
+    std::vector<int> ctyrikrat;
+    for (int opakovani = 0; opakovani < 4; opakovani++) {
+        ctyrikrat.insert(ctyrikrat.end(), cisla.begin(), cisla.begin() + 50000);
+    }
+    KvantilovyNacrt usek(200);
+    for (int i = 0; i < 50000; i++) {
+        usek.pridej(cisla[i]);
+    }
+    KvantilovyNacrt stejne_mince = usek;
+    for (int opakovani = 1; opakovani < 4; opakovani++) {
+        stejne_mince.sluc(usek);
+    }
+    EXPECT_NE(KvantilovyNacrt::z_dat(ctyrikrat, 200, nastaveni).serializuj(), stejne_mince.serializuj());
+
+    // Chyba pořadí vráceného kvantilu v mezích náčrtu
+    for (double p : {0.01, 0.25, 0.5, 0.9, 0.99}) {
+        double odhad = nacrt.kvantil(p);
+        double poradi = static_cast<double>(presne.pocet_mensich(static_cast<int>(odhad))) / cisla.size();
+        EXPECT_NEAR(poradi, p, 0.02) << "p = " << p;
+    }
+
+    // Náčrty ze dvou polovin, poslané v binární podobě a slité
+    std::span<const int> vse(cisla);
+    KvantilovyNacrt prvni(200), druhy(200);
+    for (int c : vse.first(cisla.size() / 2)) {
+        prvni.pridej(c);
+    }
+    for (int c : vse.last(cisla.size() - cisla.size() / 2)) {
+        druhy.pridej(c);
+    }
+    std::vector<unsigned char> blob = druhy.serializuj();
+    KvantilovyNacrt prijaty = KvantilovyNacrt::deserializuj(blob.data(), blob.size());
+    EXPECT_EQ(prijaty.serializuj(), blob);
+    prvni.sluc(prijaty);
+    EXPECT_EQ(prvni.pocet(), cisla.size());
+    EXPECT_EQ(prvni.minimum(), presne.data().front());
+    EXPECT_EQ(prvni.maximum(), presne.data().back());
+    double poradi = static_cast<double>(presne.pocet_mensich(static_cast<int>(prvni.median()))) / cisla.size();
+    EXPECT_NEAR(poradi, 0.5, 0.02);
+
+    blob.pop_back();
+    EXPECT_THROW(KvantilovyNacrt::deserializuj(blob.data(), blob.size()), std::invalid_argument);
+
+    KvantilovyNacrt maly;
+    for (int c : {5, 1, 3}) {
+        maly.pridej(c);
+    }
+    EXPECT_EQ(maly.median(), 3); // dokud se nezhušťuje, je náčrt přesný
+}
+
+TEST(TestyFunkci, SoucinPresne)
+{
+    std::vector<int> cisla = {1, 2, 3, 6, 6, 6, 8};
+    EXPECT_EQ(soucin_presne(cisla).na_retezec(), "10368");
+
+    cisla.clear();
+    for (int i = 1; i <= 30; i++) {
+        cisla.push_back(i);
+    }
+    EXPECT_EQ(soucin_presne(cisla).na_retezec(), "265252859812191058636308480000000"); // 30!
+
+    cisla = {-2147483647 - 1, -2147483647 - 1, -2147483647 - 1, 3};
+    EXPECT_EQ(soucin_presne(cisla).na_retezec(), "-29710560942849126597578981376"); // -3 * 2^93
+    cisla.push_back(0);
+    EXPECT_TRUE(soucin_presne(cisla).je_nula());
+    EXPECT_EQ(soucin_presne({}).na_retezec(), "1");
+
+    // Dost čísel na to, aby se ve stromu násobilo Karatsubou a paralelně;
+    // porovnáme s postupným školním násobením po jednom prvku
+    cisla.clear();
+    unsigned int stav = 5;
+    VelkeCislo postupne(1);
+    for (int i = 0; i < 3000; i++) {
+        stav = stav * 1103515245u + 12345u;
+        int c = static_cast<int>(stav) | 1;
+        cisla.push_back(c);
+        postupne = postupne * VelkeCislo(c);
+    }
+    NastaveniParalelismu nastaveni;
+    nastaveni.vlakna = 4;
+    nastaveni.prah = 0;
+    EXPECT_EQ(soucin_presne(cisla, nastaveni), postupne);
+
+    // Dolních 32 bitů (se znaménkem ve dvojkovém doplňku) odpovídá soucin v int
+    VelkeCislo presne = soucin_presne(cisla);
+    uint32_t dolni = presne.zaporne() ? 0u - presne.cislice()[0] : presne.cislice()[0];
+    EXPECT_EQ(dolni, static_cast<uint32_t>(soucin(cisla)));
+}
@@ -1,82 +1,1329 @@
 #include "vypocty.h"
 #include <iostream>
 #include <vector>
-#include <algorithm> // kvůli std::sort
-#include <sstream>   // kvůli std::stringstream
+#include <algorithm> // kvůli std::nth_element
+#include <cmath>
+#include <limits>    // kvůli quiet_NaN
+#include <string>
+#include <cstring>   // kvůli std::memcpy
+#include <charconv>  // kvůli std::from_chars
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define VYPOCTY_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VYPOCTY_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Výsledek redukce přes vektor: součet v 64 bitech (nepřeteče ani pro miliardy
+ * hodnot typu int), součin modulo 2^32 - tedy stejné bity, jaké dává násobení v int.
+ */
+struct Redukce
+{
+    long long soucet;
+    unsigned int soucin;
+};
+
+/**
+ * Skalární jádro - slouží jako záložní cesta a jako referenční výsledek pro
+ * vektorová jádra. Šablonové parametry určují, co se má počítat; fúzované
+ * statistiky() tak projdou data jen jednou.
+ */
+template <bool SOUCET, bool SOUCIN>
+static Redukce redukce_skalar(const int *data, size_t n)
+{
+    Redukce r = {0, 1};
+    for (size_t i = 0; i < n; i++) {
+        if (SOUCET) {
+            r.soucet += data[i];
+        }
+        if (SOUCIN) {
+            r.soucin *= static_cast<unsigned int>(data[i]);
+        }
+    }
+    return r;
+}
+
+#ifdef VYPOCTY_X86_SIMD
+// Součet i součin jsou v celých číslech asociativní a komutativní, proto vektorová
+// jádra dávají bitově stejný výsledek jako skalární cesta bez ohledu na pořadí.
+
+template <bool SOUCET, bool SOUCIN>
+__attribute__((target("sse4.2"))) static Redukce redukce_sse42(const int *data, size_t n)
+{
+    __m128i suma = _mm_setzero_si128(); // 2x int64
+    __m128i nasobek = _mm_set1_epi32(1); // 4x int32
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        if (SOUCET) {
+            suma = _mm_add_epi64(suma, _mm_cvtepi32_epi64(v));
+            suma = _mm_add_epi64(suma, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+        }
+        if (SOUCIN) {
+            nasobek = _mm_mullo_epi32(nasobek, v);
+        }
+    }
+
+    alignas(16) long long s[2];
+    alignas(16) unsigned int p[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(s), suma);
+    _mm_store_si128(reinterpret_cast<__m128i *>(p), nasobek);
+
+    Redukce r = redukce_skalar<SOUCET, SOUCIN>(data + i, n - i);
+    r.soucet += s[0] + s[1];
+    r.soucin *= p[0] * p[1] * p[2] * p[3];
+    return r;
+}
+
+template <bool SOUCET, bool SOUCIN>
+__attribute__((target("avx2"))) static Redukce redukce_avx2(const int *data, size_t n)
+{
+    __m256i suma0 = _mm256_setzero_si256(); // 4x int64
+    __m256i suma1 = _mm256_setzero_si256();
+    __m256i nasobek = _mm256_set1_epi32(1); // 8x int32
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        if (SOUCET) {
+            suma0 = _mm256_add_epi64(suma0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            suma1 = _mm256_add_epi64(suma1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        if (SOUCIN) {
+            nasobek = _mm256_mullo_epi32(nasobek, v);
+        }
+    }
+
+    alignas(32) long long s[4];
+    alignas(32) unsigned int p[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(s), _mm256_add_epi64(suma0, suma1));
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), nasobek);
+
+    Redukce r = redukce_skalar<SOUCET, SOUCIN>(data + i, n - i);
+    r.soucet += s[0] + s[1] + s[2] + s[3];
+    for (unsigned int x : p) {
+        r.soucin *= x;
+    }
+    return r;
+}
+
+template <bool SOUCET, bool SOUCIN>
+__attribute__((target("avx512f"))) static Redukce redukce_avx512(const int *data, size_t n)
+{
+    __m512i suma0 = _mm512_setzero_si512(); // 8x int64
+    __m512i suma1 = _mm512_setzero_si512();
+    __m512i nasobek = _mm512_set1_epi32(1); // 16x int32
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        if (SOUCET) {
+            suma0 = _mm512_add_epi64(suma0, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+            suma1 = _mm512_add_epi64(suma1, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+        }
+        if (SOUCIN) {
+            nasobek = _mm512_mullo_epi32(nasobek, v);
+        }
+    }
+
+    Redukce r = redukce_skalar<SOUCET, SOUCIN>(data + i, n - i);
+    r.soucet += _mm512_reduce_add_epi64(_mm512_add_epi64(suma0, suma1));
+    r.soucin *= static_cast<unsigned int>(_mm512_reduce_mul_epi32(nasobek));
+    return r;
+}
+#endif // VYPOCTY_X86_SIMD
+
+typedef Redukce (*RedukceJadro)(const int *, size_t);
+
+/**
+ * Vybere nejširší jádro, které podporuje procesor (CPUID), jinak skalární.
+ */
+template <bool SOUCET, bool SOUCIN>
+static RedukceJadro vyber_redukci()
+{
+#ifdef VYPOCTY_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return redukce_avx512<SOUCET, SOUCIN>;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return redukce_avx2<SOUCET, SOUCIN>;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return redukce_sse42<SOUCET, SOUCIN>;
+    }
+#endif
+    return redukce_skalar<SOUCET, SOUCIN>;
+}
+
+template <bool SOUCET, bool SOUCIN>
+static Redukce redukce(const int *data, size_t n)
+{
+    // Výběr proběhne jen jednou, při prvním volání
+    static const RedukceJadro jadro = vyber_redukci<SOUCET, SOUCIN>();
+    return jadro(data, n);
+}
+
+long long soucet_vektorove(const int *data, size_t n)
+{
+    return redukce<true, false>(data, n).soucet;
+}
+
+unsigned int soucin_vektorove(const int *data, size_t n)
+{
+    return redukce<false, true>(data, n).soucin;
+}
+
+// Původní rozhraní pro std::vector<int> předává práci obecným šablonám
 
 int soucet(const std::vector<int> &cisla)
 {
-    // TODO: Implementujte funkci
-    int vysledek = 0;
-    for (int c : cisla) {
-        vysledek += c;
+    return static_cast<int>(soucet(std::span<const int>(cisla)));
+}
+
+int soucin(const std::vector<int> &cisla)
+{
+    return soucin(std::span<const int>(cisla));
+}
+
+double prumer(const std::vector<int> &cisla)
+{
+    return prumer(std::span<const int>(cisla));
+}
+
+double median(const std::vector<int> &cisla)
+{
+    return median(std::span<const int>(cisla));
+}
+
+Statistiky statistiky(const std::vector<int> &cisla)
+{
+    // Součet i součin v jednom průchodu daty
+    Redukce r = redukce<true, true>(cisla.data(), cisla.size());
+
+    Statistiky vysledek;
+    vysledek.soucet = static_cast<int>(r.soucet);
+    vysledek.soucin = static_cast<int>(r.soucin);
+    vysledek.prumer = static_cast<double>(r.soucet) / cisla.size();
+
+    // Medián potřebuje jedinou kopii, nad kterou proběhne výběr
+    std::vector<int> kopie = cisla;
+    vysledek.median = median_na_miste<int>(kopie);
+    return vysledek;
+}
+
+/**
+ * Počet vláken pro vstup délky n podle nastavení; 1 znamená jednovláknovou cestu.
+ */
+static unsigned int pocet_vlaken(size_t n, const NastaveniParalelismu &nastaveni)
+{
+    if (n < nastaveni.prah) {
+        return 1;
     }
+    unsigned int vlakna = nastaveni.vlakna;
+    if (vlakna == 0) {
+        vlakna = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Každé vlákno dostane aspoň několik tisíc prvků, jinak se nevyplatí
+    size_t nejvic = std::max<size_t>(1, n / 4096);
+    return static_cast<unsigned int>(std::min<size_t>(vlakna, nejvic));
+}
+
+/**
+ * Spustí ukol(i) pro i = 0..vlakna-1, každý ve vlastním vlákně (úloha 0 běží ve
+ * volajícím vlákně), a počká na dokončení všech. Vlákna se zakládají pro každé
+ * volání - u vstupů nad prahem je to zanedbatelné proti samotnému výpočtu.
+ */
+static void paralelne(unsigned int vlakna, const std::function<void(unsigned int)> &ukol)
+{
+    std::vector<std::thread> pracovnici;
+    pracovnici.reserve(vlakna - 1);
+    for (unsigned int i = 1; i < vlakna; i++) {
+        pracovnici.emplace_back(ukol, i);
+    }
+    ukol(0);
+    for (std::thread &t : pracovnici) {
+        t.join();
+    }
+}
+
+// Hranice i-tého z k souvislých úseků pole délky n
+static size_t hranice_useku(size_t n, unsigned int k, unsigned int i)
+{
+    return n / k * i + std::min<size_t>(i, n % k);
+}
+
+/**
+ * Redukce rozdělená na souvislé úseky, jeden na vlákno. Dílčí výsledky se sčítají
+ * v pořadí úseků, takže výsledek nezávisí na tom, které vlákno doběhne dřív.
+ */
+template <bool SOUCET, bool SOUCIN>
+static Redukce redukce_paralelne(const std::vector<int> &cisla, const NastaveniParalelismu &nastaveni)
+{
+    static const RedukceJadro jadro = vyber_redukci<SOUCET, SOUCIN>();
+    unsigned int vlakna = pocet_vlaken(cisla.size(), nastaveni);
+    std::vector<Redukce> dilci(vlakna);
+    paralelne(vlakna, [&](unsigned int i) {
+        size_t od = hranice_useku(cisla.size(), vlakna, i);
+        size_t po = hranice_useku(cisla.size(), vlakna, i + 1);
+        dilci[i] = jadro(cisla.data() + od, po - od);
+    });
+
+    Redukce r = {0, 1};
+    for (const Redukce &d : dilci) {
+        r.soucet += d.soucet;
+        r.soucin *= d.soucin;
+    }
+    return r;
+}
+
+int soucet_paralelne(const std::vector<int> &cisla, const NastaveniParalelismu &nastaveni)
+{
+    return static_cast<int>(redukce_paralelne<true, false>(cisla, nastaveni).soucet);
+}
+
+int soucin_paralelne(const std::vector<int> &cisla, const NastaveniParalelismu &nastaveni)
+{
+    return static_cast<int>(redukce_paralelne<false, true>(cisla, nastaveni).soucin);
+}
+
+double prumer_paralelne(const std::vector<int> &cisla, const NastaveniParalelismu &nastaveni)
+{
+    return static_cast<double>(redukce_paralelne<true, false>(cisla, nastaveni).soucet) / cisla.size();
+}
+
+/**
+ * Paralelní medián výběrem podle vzorku:
+ * 1. Ze vzorku dat se odhadne interval hodnot [dolni, horni], ve kterém medián leží.
+ * 2. Vlákna spočítají, kolik prvků je pod intervalem a kolik v něm.
+ * 3. Prvky z intervalu (malý zlomek dat) se paralelně zkopírují do bufferu
+ *    a medián se vybere v něm pomocí nth_element.
+ * Pokud vzorek interval netrefí, spočítá se medián jednovláknově.
+ */
+double median_paralelne(const std::vector<int> &cisla, const NastaveniParalelismu &nastaveni)
+{
+    size_t n = cisla.size();
+    unsigned int vlakna = pocet_vlaken(n, nastaveni);
+    if (vlakna <= 1) {
+        return median(cisla);
+    }
+
+    // Pořadí hledaných prvků (u lichého n jsou obě stejná)
+    size_t k1 = (n - 1) / 2;
+    size_t k2 = n / 2;
+
+    // Pravidelný vzorek; rezerva kolem pozice mediánu ~ 3 směrodatné odchylky
+    size_t velikost_vzorku = std::min<size_t>(n, 1 << 16);
+    std::vector<int> vzorek(velikost_vzorku);
+    for (size_t i = 0; i < velikost_vzorku; i++) {
+        vzorek[i] = cisla[i * (n / velikost_vzorku)];
+    }
+    std::sort(vzorek.begin(), vzorek.end());
+    size_t rezerva = 3 * static_cast<size_t>(std::sqrt(static_cast<double>(velikost_vzorku))) + 1;
+    size_t stred = velikost_vzorku / 2;
+    int dolni = vzorek[stred > rezerva ? stred - rezerva : 0];
+    int horni = vzorek[std::min(velikost_vzorku - 1, stred + rezerva)];
+
+    // Počty prvků pod intervalem a v něm, pro každý úsek zvlášť
+    std::vector<size_t> pod(vlakna), uvnitr(vlakna);
+    paralelne(vlakna, [&](unsigned int i) {
+        size_t p = 0, u = 0;
+        for (size_t j = hranice_useku(n, vlakna, i); j < hranice_useku(n, vlakna, i + 1); j++) {
+            p += cisla[j] < dolni;
+            u += cisla[j] >= dolni && cisla[j] <= horni;
+        }
+        pod[i] = p;
+        uvnitr[i] = u;
+    });
+
+    size_t celkem_pod = 0, celkem_uvnitr = 0;
+    std::vector<size_t> zacatky(vlakna);
+    for (unsigned int i = 0; i < vlakna; i++) {
+        zacatky[i] = celkem_uvnitr;
+        celkem_pod += pod[i];
+        celkem_uvnitr += uvnitr[i];
+    }
+    if (k1 < celkem_pod || k2 >= celkem_pod + celkem_uvnitr) {
+        return median(cisla); // vzorek nebyl reprezentativní
+    }
+
+    // Každé vlákno zapisuje do své předem spočítané části bufferu
+    std::vector<int> kandidati(celkem_uvnitr);
+    paralelne(vlakna, [&](unsigned int i) {
+        size_t zapis = zacatky[i];
+        for (size_t j = hranice_useku(n, vlakna, i); j < hranice_useku(n, vlakna, i + 1); j++) {
+            if (cisla[j] >= dolni && cisla[j] <= horni) {
+                kandidati[zapis++] = cisla[j];
+            }
+        }
+    });
+
+    auto druhy = kandidati.begin() + (k2 - celkem_pod);
+    std::nth_element(kandidati.begin(), druhy, kandidati.end());
+    if (k1 == k2) {
+        return *druhy;
+    }
+    int prvni = *std::max_element(kandidati.begin(), druhy);
+    return (static_cast<double>(prvni) + *druhy) / 2.0;
+}
+
+// Dvojice indexů pro porovnání a prohození v třídicí síti
+struct Komparator
+{
+    unsigned char a, b;
+};
+
+// Třídicí sítě s minimálním počtem komparátorů pro 2 až 8 prvků
+static const Komparator sit2[] = {{0, 1}};
+static const Komparator sit3[] = {{0, 2}, {0, 1}, {1, 2}};
+static const Komparator sit4[] = {{0, 2}, {1, 3}, {0, 1}, {2, 3}, {1, 2}};
+static const Komparator sit5[] = {{0, 3}, {1, 4}, {0, 2}, {1, 3}, {0, 1}, {2, 4}, {1, 2}, {3, 4}, {2, 3}};
+static const Komparator sit6[] = {{0, 5}, {1, 3}, {2, 4}, {1, 2}, {3, 4}, {0, 3},
+                                  {2, 5}, {0, 1}, {2, 3}, {4, 5}, {1, 2}, {3, 4}};
+static const Komparator sit7[] = {{0, 6}, {2, 3}, {4, 5}, {0, 2}, {1, 4}, {3, 6}, {0, 1}, {2, 5},
+                                  {3, 4}, {1, 2}, {4, 6}, {2, 3}, {4, 5}, {1, 2}, {3, 4}, {5, 6}};
+static const Komparator sit8[] = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6},
+                                  {3, 7}, {0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5},
+                                  {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+static const size_t NEJVETSI_SIT = 8;
+
+/**
+ * Setřídí nejvýše NEJVETSI_SIT prvků pevnou třídicí sítí. Porovnání nezávisí
+ * na datech, takže se přeloží na min/max bez podmíněných skoků.
+ */
+static void serad_siti(int *data, size_t n)
+{
+    const Komparator *sit = nullptr;
+    size_t delka = 0;
+    switch (n) {
+    case 2: sit = sit2; delka = std::size(sit2); break;
+    case 3: sit = sit3; delka = std::size(sit3); break;
+    case 4: sit = sit4; delka = std::size(sit4); break;
+    case 5: sit = sit5; delka = std::size(sit5); break;
+    case 6: sit = sit6; delka = std::size(sit6); break;
+    case 7: sit = sit7; delka = std::size(sit7); break;
+    case 8: sit = sit8; delka = std::size(sit8); break;
+    default: return; // 0 nebo 1 prvek je setříděný
+    }
+    for (size_t i = 0; i < delka; i++) {
+        int x = data[sit[i].a];
+        int y = data[sit[i].b];
+        data[sit[i].a] = std::min(x, y);
+        data[sit[i].b] = std::max(x, y);
+    }
+}
+
+DavkoveStatistiky davkove_statistiky(std::span<const int> hodnoty, std::span<const size_t> offsety,
+                                     const NastaveniParalelismu &nastaveni)
+{
+    size_t pocet_rad = offsety.empty() ? 0 : offsety.size() - 1;
+    for (size_t i = 0; i < pocet_rad; i++) {
+        if (offsety[i] > offsety[i + 1] || offsety[i + 1] > hodnoty.size()) {
+            throw std::invalid_argument("davkove_statistiky: neplatné offsety řady " + std::to_string(i));
+        }
+    }
+
+    DavkoveStatistiky vysledek;
+    vysledek.soucty.resize(pocet_rad);
+    vysledek.prumery.resize(pocet_rad);
+    vysledek.mediany.resize(pocet_rad);
+
+    // Řady se rozdělí mezi vlákna po souvislých úsecích; každé vlákno má jeden
+    // pracovní buffer pro medián, takže se nealokuje pro každou řadu zvlášť.
+    unsigned int vlakna = pocet_vlaken(hodnoty.size(), nastaveni);
+    vlakna = static_cast<unsigned int>(std::min<size_t>(vlakna, std::max<size_t>(1, pocet_rad)));
+    paralelne(vlakna, [&](unsigned int v) {
+        std::vector<int> pracovni;
+        int mala[NEJVETSI_SIT];
+        for (size_t i = hranice_useku(pocet_rad, vlakna, v); i < hranice_useku(pocet_rad, vlakna, v + 1); i++) {
+            const int *rada = hodnoty.data() + offsety[i];
+            size_t n = offsety[i + 1] - offsety[i];
+
+            long long suma = redukce<true, false>(rada, n).soucet;
+            vysledek.soucty[i] = suma;
+            vysledek.prumery[i] = static_cast<double>(suma) / n;
+
+            if (n == 0) {
+                vysledek.mediany[i] = std::numeric_limits<double>::quiet_NaN();
+            } else if (n <= NEJVETSI_SIT) {
+                std::copy(rada, rada + n, mala);
+                serad_siti(mala, n);
+                vysledek.mediany[i] = (static_cast<double>(mala[(n - 1) / 2]) + mala[n / 2]) / 2.0;
+            } else {
+                pracovni.assign(rada, rada + n);
+                vysledek.mediany[i] = median_na_miste<int>(pracovni);
+            }
+        }
+    });
     return vysledek;
 }
 
-int soucin(const std::vector<int> &cisla)
+SerazenyPohled::SerazenyPohled(const std::vector<int> &cisla) : m_data(cisla)
+{
+    std::sort(m_data.begin(), m_data.end());
+}
+
+double SerazenyPohled::kvantil(double p) const
+{
+    if (!(p >= 0.0 && p <= 1.0)) {
+        throw std::invalid_argument("SerazenyPohled::kvantil: p musí být z intervalu [0, 1]");
+    }
+    if (m_data.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // Poloha kvantilu mezi prvky 0 .. n-1, mezi sousedy se interpoluje
+    double poloha = p * (m_data.size() - 1);
+    size_t dolni = static_cast<size_t>(poloha);
+    double zlomek = poloha - dolni;
+    if (zlomek == 0.0) {
+        return m_data[dolni];
+    }
+    double a = m_data[dolni];
+    double b = m_data[dolni + 1];
+    return a + zlomek * (b - a);
+}
+
+size_t SerazenyPohled::pocet_mensich(int hodnota) const
+{
+    return static_cast<size_t>(std::lower_bound(m_data.begin(), m_data.end(), hodnota) - m_data.begin());
+}
+
+size_t SerazenyPohled::pocet_nejvyse(int hodnota) const
+{
+    return static_cast<size_t>(std::upper_bound(m_data.begin(), m_data.end(), hodnota) - m_data.begin());
+}
+
+void SerazenyPohled::pridej(const std::vector<int> &davka)
+{
+    size_t puvodni = m_data.size();
+    m_data.insert(m_data.end(), davka.begin(), davka.end());
+    std::sort(m_data.begin() + puvodni, m_data.end());
+    std::inplace_merge(m_data.begin(), m_data.begin() + puvodni, m_data.end());
+}
+
+void SerazenyPohled::pridej(int hodnota)
 {
-    // TODO: Implementujte funkci
+    m_data.insert(std::upper_bound(m_data.begin(), m_data.end(), hodnota), hodnota);
+}
+
+KlouzaveOkno::KlouzaveOkno(size_t sirka) : m_sirka(sirka)
+{
+    if (sirka == 0) {
+        throw std::invalid_argument("KlouzaveOkno: šířka okna musí být kladná");
+    }
+    m_okno.resize(sirka);
+}
+
+void KlouzaveOkno::pridej(int hodnota)
+{
+    if (plne()) {
+        // Odebereme nejstarší hodnotu z té poloviny, ve které leží. Všechny prvky
+        // dolní poloviny jsou <= prvkům horní, takže hodnota <= max(dolni) je v dolní.
+        int stara = m_okno[m_nejstarsi];
+        m_soucet -= stara;
+        if (stara <= *m_dolni.rbegin()) {
+            m_dolni.erase(m_dolni.find(stara));
+        } else {
+            m_horni.erase(m_horni.find(stara));
+        }
+        vyrovnej(); // aby porovnání s max(dolni) níže platilo i po odebrání
+        m_okno[m_nejstarsi] = hodnota;
+        m_nejstarsi = (m_nejstarsi + 1) % m_sirka;
+    } else {
+        m_okno[(m_nejstarsi + m_pocet) % m_sirka] = hodnota;
+        m_pocet++;
+    }
+
+    m_soucet += hodnota;
+    if (m_dolni.empty() || hodnota <= *m_dolni.rbegin()) {
+        m_dolni.insert(hodnota);
+    } else {
+        m_horni.insert(hodnota);
+    }
+    vyrovnej();
+}
+
+void KlouzaveOkno::vyrovnej()
+{
+    if (m_dolni.size() > m_horni.size() + 1) {
+        auto nejvetsi = std::prev(m_dolni.end());
+        m_horni.insert(*nejvetsi);
+        m_dolni.erase(nejvetsi);
+    } else if (m_horni.size() > m_dolni.size()) {
+        auto nejmensi = m_horni.begin();
+        m_dolni.insert(*nejmensi);
+        m_horni.erase(nejmensi);
+    }
+}
+
+double KlouzaveOkno::prumer() const
+{
+    return static_cast<double>(m_soucet) / m_pocet;
+}
+
+double KlouzaveOkno::median() const
+{
+    if (m_pocet == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (m_dolni.size() > m_horni.size()) {
+        // pokud je počet prvků lichý
+        return *m_dolni.rbegin();
+    }
+    // pokud je počet prvků sudý
+    return (static_cast<double>(*m_dolni.rbegin()) + *m_horni.begin()) / 2.0;
+}
+
+DavkoveStatistiky klouzave_statistiky(std::span<const int> cisla, size_t sirka)
+{
+    KlouzaveOkno okno(sirka);
+    DavkoveStatistiky vysledek;
+    size_t pocet_oken = cisla.size() >= sirka ? cisla.size() - sirka + 1 : 0;
+    vysledek.soucty.reserve(pocet_oken);
+    vysledek.prumery.reserve(pocet_oken);
+    vysledek.mediany.reserve(pocet_oken);
 
-    int vysledek = 1;
     for (int c : cisla) {
-        vysledek *= c;
+        okno.pridej(c);
+        if (okno.plne()) {
+            vysledek.soucty.push_back(okno.soucet());
+            vysledek.prumery.push_back(okno.prumer());
+            vysledek.mediany.push_back(okno.median());
+        }
     }
     return vysledek;
 }
 
-double prumer(const std::vector<int> &cisla)
+KvantilovyNacrt::KvantilovyNacrt(uint32_t k) : m_k(std::max<uint32_t>(k, 8)), m_urovne(1)
+{
+}
+
+size_t KvantilovyNacrt::kapacita(size_t uroven) const
+{
+    // Nejvyšší úroveň má kapacitu k, každá nižší 2/3 kapacity úrovně nad ní
+    size_t hloubka = m_urovne.size() - 1 - uroven;
+    double kap = std::ceil(m_k * std::pow(2.0 / 3.0, static_cast<double>(hloubka)));
+    return std::max<size_t>(2, static_cast<size_t>(kap));
+}
+
+size_t KvantilovyNacrt::velikost() const
 {
-    // TODO: Implementujte funkci
+    size_t celkem = 0;
+    for (const std::vector<int> &uroven : m_urovne) {
+        celkem += uroven.size();
+    }
+    return celkem;
+}
 
-    double suma = 0.0;
+/**
+ * Dokud je náčrt přeplněný, zhustí nejnižší plnou úroveň: setřídí ji a náhodně
+ * zvolené sudé nebo liché prvky z párů posune o úroveň výš (s dvojnásobnou vahou).
+ * Při lichém počtu zůstane největší prvek na místě, celková váha se tak zachová.
+ */
+void KvantilovyNacrt::zhustit()
+{
+    while (true) {
+        size_t celkova_kapacita = 0;
+        for (size_t h = 0; h < m_urovne.size(); h++) {
+            celkova_kapacita += kapacita(h);
+        }
+        if (velikost() < celkova_kapacita) {
+            return;
+        }
+
+        size_t h = 0;
+        while (m_urovne[h].size() < kapacita(h)) {
+            h++;
+        }
+        if (h + 1 == m_urovne.size()) {
+            m_urovne.emplace_back();
+        }
+
+        std::vector<int> &uroven = m_urovne[h];
+        std::sort(uroven.begin(), uroven.end());
+        // xorshift64 - stačí jeden náhodný bit na zhuštění
+        m_nahoda ^= m_nahoda << 13;
+        m_nahoda ^= m_nahoda >> 7;
+        m_nahoda ^= m_nahoda << 17;
+        size_t posun = m_nahoda & 1;
+
+        size_t pary = uroven.size() / 2 * 2;
+        for (size_t i = posun; i < pary; i += 2) {
+            m_urovne[h + 1].push_back(uroven[i]);
+        }
+        uroven.erase(uroven.begin(), uroven.begin() + pary);
+    }
+}
+
+void KvantilovyNacrt::pridej(int hodnota)
+{
+    m_pocet++;
+    m_soucet += hodnota;
+    m_minimum = std::min(m_minimum, hodnota);
+    m_maximum = std::max(m_maximum, hodnota);
+    m_urovne[0].push_back(hodnota);
+    if (m_urovne[0].size() >= kapacita(0)) {
+        zhustit();
+    }
+}
+
+void KvantilovyNacrt::sluc(const KvantilovyNacrt &jiny)
+{
+    m_k = std::min(m_k, jiny.m_k);
+    m_pocet += jiny.m_pocet;
+    m_soucet += jiny.m_soucet;
+    m_minimum = std::min(m_minimum, jiny.m_minimum);
+    m_maximum = std::max(m_maximum, jiny.m_maximum);
+    m_nahoda ^= jiny.m_nahoda;
+    if (m_nahoda == 0) {
+        m_nahoda = 0x9E3779B97F4A7C15ULL;
+    }
+
+    if (m_urovne.size() < jiny.m_urovne.size()) {
+        m_urovne.resize(jiny.m_urovne.size());
+    }
+    for (size_t h = 0; h < jiny.m_urovne.size(); h++) {
+        m_urovne[h].insert(m_urovne[h].end(), jiny.m_urovne[h].begin(), jiny.m_urovne[h].end());
+    }
+    zhustit();
+}
+
+KvantilovyNacrt KvantilovyNacrt::z_dat(std::span<const int> cisla, uint32_t k,
+                                       const NastaveniParalelismu &nastaveni)
+{
+    unsigned int vlakna = pocet_vlaken(cisla.size(), nastaveni);
+    std::vector<KvantilovyNacrt> dilci(vlakna, KvantilovyNacrt(k));
+    // Každý úsek musí házet vlastní mincí - se stejným semenem by se zhušťovaly shodně
+    // a XOR ve sluc by stejná semena vynuloval. Úsek 0 si nechává výchozí semeno.
+    for (unsigned int i = 1; i < vlakna; i++) {
+        uint64_t semeno = dilci[i].m_nahoda + i * 0x9E3779B97F4A7C15ULL; // splitmix64
+        semeno = (semeno ^ (semeno >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        semeno = (semeno ^ (semeno >> 27)) * 0x94D049BB133111EBULL;
+        semeno ^= semeno >> 31;
+        dilci[i].m_nahoda = semeno != 0 ? semeno : 0x9E3779B97F4A7C15ULL;
+    }
+    paralelne(vlakna, [&](unsigned int i) {
+        for (size_t j = hranice_useku(cisla.size(), vlakna, i); j < hranice_useku(cisla.size(), vlakna, i + 1); j++) {
+            dilci[i].pridej(cisla[j]);
+        }
+    });
+
+    // Slévá se v pořadí úseků, výsledek je tedy pro daný počet vláken vždy stejný
+    for (unsigned int i = 1; i < vlakna; i++) {
+        dilci[0].sluc(dilci[i]);
+    }
+    return dilci[0];
+}
+
+double KvantilovyNacrt::prumer() const
+{
+    return static_cast<double>(m_soucet) / m_pocet;
+}
+
+double KvantilovyNacrt::kvantil(double p) const
+{
+    if (!(p >= 0.0 && p <= 1.0)) {
+        throw std::invalid_argument("KvantilovyNacrt::kvantil: p musí být z intervalu [0, 1]");
+    }
+    if (m_pocet == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (p == 0.0) {
+        return m_minimum;
+    }
+    if (p == 1.0) {
+        return m_maximum;
+    }
+
+    // Vážené hodnoty ze všech úrovní setříděné podle hodnoty
+    std::vector<std::pair<int, uint64_t>> vazene;
+    vazene.reserve(velikost());
+    for (size_t h = 0; h < m_urovne.size(); h++) {
+        for (int hodnota : m_urovne[h]) {
+            vazene.emplace_back(hodnota, uint64_t(1) << h);
+        }
+    }
+    std::sort(vazene.begin(), vazene.end());
+
+    double poradi = p * static_cast<double>(m_pocet);
+    uint64_t kumulativne = 0;
+    for (const std::pair<int, uint64_t> &v : vazene) {
+        kumulativne += v.second;
+        if (static_cast<double>(kumulativne) > poradi) {
+            return v.first;
+        }
+    }
+    return m_maximum;
+}
+
+// Zápis a čtení čísel po bajtech v pořadí little-endian, nezávisle na platformě
+static void zapis_cislo(std::vector<unsigned char> &vystup, uint64_t hodnota, int bajtu)
+{
+    for (int i = 0; i < bajtu; i++) {
+        vystup.push_back(static_cast<unsigned char>(hodnota >> (8 * i)));
+    }
+}
+
+static uint64_t precti_cislo(const unsigned char *&data, const unsigned char *konec, int bajtu)
+{
+    if (konec - data < bajtu) {
+        throw std::invalid_argument("KvantilovyNacrt::deserializuj: data jsou zkrácená");
+    }
+    uint64_t hodnota = 0;
+    for (int i = 0; i < bajtu; i++) {
+        hodnota |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    data += bajtu;
+    return hodnota;
+}
+
+static const uint32_t NACRT_ZNACKA = 0x314C4C4B; // "KLL1"
+
+std::vector<unsigned char> KvantilovyNacrt::serializuj() const
+{
+    std::vector<unsigned char> vystup;
+    vystup.reserve(48 + 4 * velikost() + 4 * m_urovne.size());
+    zapis_cislo(vystup, NACRT_ZNACKA, 4);
+    zapis_cislo(vystup, m_k, 4);
+    zapis_cislo(vystup, m_pocet, 8);
+    zapis_cislo(vystup, static_cast<uint64_t>(m_soucet), 8);
+    zapis_cislo(vystup, static_cast<uint32_t>(m_minimum), 4);
+    zapis_cislo(vystup, static_cast<uint32_t>(m_maximum), 4);
+    zapis_cislo(vystup, m_nahoda, 8);
+    zapis_cislo(vystup, m_urovne.size(), 4);
+    for (const std::vector<int> &uroven : m_urovne) {
+        zapis_cislo(vystup, uroven.size(), 4);
+        for (int hodnota : uroven) {
+            zapis_cislo(vystup, static_cast<uint32_t>(hodnota), 4);
+        }
+    }
+    return vystup;
+}
+
+KvantilovyNacrt KvantilovyNacrt::deserializuj(const unsigned char *data, size_t delka)
+{
+    const unsigned char *konec = data + delka;
+    if (precti_cislo(data, konec, 4) != NACRT_ZNACKA) {
+        throw std::invalid_argument("KvantilovyNacrt::deserializuj: neznámý formát");
+    }
+    KvantilovyNacrt nacrt(static_cast<uint32_t>(precti_cislo(data, konec, 4)));
+    nacrt.m_pocet = precti_cislo(data, konec, 8);
+    nacrt.m_soucet = static_cast<long long>(precti_cislo(data, konec, 8));
+    nacrt.m_minimum = static_cast<int>(static_cast<uint32_t>(precti_cislo(data, konec, 4)));
+    nacrt.m_maximum = static_cast<int>(static_cast<uint32_t>(precti_cislo(data, konec, 4)));
+    nacrt.m_nahoda = precti_cislo(data, konec, 8);
+
+    size_t pocet_urovni = precti_cislo(data, konec, 4);
+    if (pocet_urovni == 0 || pocet_urovni > 64) {
+        throw std::invalid_argument("KvantilovyNacrt::deserializuj: neplatný počet úrovní");
+    }
+    nacrt.m_urovne.assign(pocet_urovni, {});
+    uint64_t vaha = 0;
+    for (size_t h = 0; h < pocet_urovni; h++) {
+        size_t velikost = precti_cislo(data, konec, 4);
+        if (static_cast<size_t>(konec - data) / 4 < velikost) {
+            throw std::invalid_argument("KvantilovyNacrt::deserializuj: data jsou zkrácená");
+        }
+        nacrt.m_urovne[h].reserve(velikost);
+        for (size_t i = 0; i < velikost; i++) {
+            nacrt.m_urovne[h].push_back(static_cast<int>(static_cast<uint32_t>(precti_cislo(data, konec, 4))));
+        }
+        vaha += static_cast<uint64_t>(velikost) << h;
+    }
+    if (vaha != nacrt.m_pocet || data != konec) {
+        throw std::invalid_argument("KvantilovyNacrt::deserializuj: nekonzistentní data");
+    }
+    return nacrt;
+}
+
+typedef std::vector<uint32_t> Cislice;
+
+// Pod tímto počtem číslic je školní násobení rychlejší než Karatsuba
+static const size_t KARATSUBA_PRAH = 32;
+
+static void orizni(Cislice &a)
+{
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+static Cislice nasob_skolsky(const uint32_t *a, size_t na, const uint32_t *b, size_t nb)
+{
+    Cislice v(na + nb, 0);
+    for (size_t i = 0; i < na; i++) {
+        uint64_t prenos = 0;
+        for (size_t j = 0; j < nb; j++) {
+            uint64_t t = static_cast<uint64_t>(a[i]) * b[j] + v[i + j] + prenos;
+            v[i + j] = static_cast<uint32_t>(t);
+            prenos = t >> 32;
+        }
+        v[i + nb] = static_cast<uint32_t>(prenos);
+    }
+    orizni(v);
+    return v;
+}
+
+// v += a * 2^(32 * posun)
+static void pricti(Cislice &v, const Cislice &a, size_t posun)
+{
+    if (v.size() < a.size() + posun) {
+        v.resize(a.size() + posun, 0);
+    }
+    uint64_t prenos = 0;
+    size_t i = 0;
+    for (; i < a.size(); i++) {
+        uint64_t t = static_cast<uint64_t>(v[i + posun]) + a[i] + prenos;
+        v[i + posun] = static_cast<uint32_t>(t);
+        prenos = t >> 32;
+    }
+    for (; prenos != 0 && i + posun < v.size(); i++) {
+        uint64_t t = static_cast<uint64_t>(v[i + posun]) + prenos;
+        v[i + posun] = static_cast<uint32_t>(t);
+        prenos = t >> 32;
+    }
+    if (prenos != 0) {
+        v.push_back(static_cast<uint32_t>(prenos));
+    }
+}
+
+// v -= a, předpokládá v >= a
+static void odecti(Cislice &v, const Cislice &a)
+{
+    int64_t vypujcka = 0;
+    for (size_t i = 0; i < v.size(); i++) {
+        int64_t t = static_cast<int64_t>(v[i]) - (i < a.size() ? a[i] : 0) - vypujcka;
+        vypujcka = t < 0;
+        v[i] = static_cast<uint32_t>(t + (vypujcka << 32));
+        if (i >= a.size() && vypujcka == 0) {
+            break;
+        }
+    }
+    orizni(v);
+}
+
+static Cislice nasob(const uint32_t *a, size_t na, const uint32_t *b, size_t nb)
+{
+    while (na > 0 && a[na - 1] == 0) {
+        na--;
+    }
+    while (nb > 0 && b[nb - 1] == 0) {
+        nb--;
+    }
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb == 0) {
+        return {};
+    }
+    if (nb < KARATSUBA_PRAH) {
+        return nasob_skolsky(a, na, b, nb);
+    }
+
+    size_t m = na / 2;
+    if (nb <= m) {
+        // Nevyvážené délky: a = a1 * B^m + a0, výsledek = a0 * b + (a1 * b) * B^m
+        Cislice v = nasob(a, m, b, nb);
+        pricti(v, nasob(a + m, na - m, b, nb), m);
+        orizni(v);
+        return v;
+    }
+
+    // Karatsuba: (a1 B + a0)(b1 B + b0) = z2 B^2 + z1 B + z0,
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2 - tři násobení místo čtyř
+    Cislice z0 = nasob(a, m, b, m);
+    Cislice z2 = nasob(a + m, na - m, b + m, nb - m);
+    Cislice sa(a, a + m);
+    pricti(sa, Cislice(a + m, a + na), 0);
+    Cislice sb(b, b + m);
+    pricti(sb, Cislice(b + m, b + nb), 0);
+    Cislice z1 = nasob(sa.data(), sa.size(), sb.data(), sb.size());
+    odecti(z1, z0);
+    odecti(z1, z2);
+
+    Cislice v = z0;
+    pricti(v, z1, m);
+    pricti(v, z2, 2 * m);
+    orizni(v);
+    return v;
+}
+
+VelkeCislo::VelkeCislo(long long hodnota) : m_zaporne(hodnota < 0)
+{
+    // Absolutní hodnota v unsigned, aby fungovala i pro nejmenší long long
+    unsigned long long absolutni = m_zaporne ? 0ULL - static_cast<unsigned long long>(hodnota)
+                                             : static_cast<unsigned long long>(hodnota);
+    while (absolutni != 0) {
+        m_cislice.push_back(static_cast<uint32_t>(absolutni));
+        absolutni >>= 32;
+    }
+}
+
+VelkeCislo VelkeCislo::operator*(const VelkeCislo &b) const
+{
+    VelkeCislo v;
+    v.m_cislice = nasob(m_cislice.data(), m_cislice.size(), b.m_cislice.data(), b.m_cislice.size());
+    v.m_zaporne = !v.je_nula() && (m_zaporne != b.m_zaporne);
+    return v;
+}
+
+std::string VelkeCislo::na_retezec() const
+{
+    if (je_nula()) {
+        return "0";
+    }
+    // Opakované dělení 10^9 - každý zbytek dává devět desítkových číslic
+    Cislice zbytek = m_cislice;
+    std::vector<uint32_t> skupiny;
+    while (!zbytek.empty()) {
+        uint64_t r = 0;
+        for (size_t i = zbytek.size(); i-- > 0;) {
+            uint64_t t = (r << 32) | zbytek[i];
+            zbytek[i] = static_cast<uint32_t>(t / 1000000000u);
+            r = t % 1000000000u;
+        }
+        skupiny.push_back(static_cast<uint32_t>(r));
+        orizni(zbytek);
+    }
+
+    std::string vysledek = m_zaporne ? "-" : "";
+    vysledek += std::to_string(skupiny.back());
+    for (size_t i = skupiny.size() - 1; i-- > 0;) {
+        std::string skupina = std::to_string(skupiny[i]);
+        vysledek.append(9 - skupina.size(), '0');
+        vysledek += skupina;
+    }
+    return vysledek;
+}
+
+std::ostream &operator<<(std::ostream &os, const VelkeCislo &cislo)
+{
+    return os << cislo.na_retezec();
+}
+
+/**
+ * Součin listy[od .. po) vyváženým stromem. Dokud zbývají vlákna, počítá se
+ * levý podstrom v novém vlákně a pravý ve stávajícím.
+ */
+static VelkeCislo soucin_stromem(const std::vector<VelkeCislo> &listy, size_t od, size_t po, unsigned int vlakna)
+{
+    if (po - od == 1) {
+        return listy[od];
+    }
+    size_t stred = od + (po - od) / 2;
+    if (vlakna > 1) {
+        VelkeCislo levy;
+        std::thread t([&]() { levy = soucin_stromem(listy, od, stred, vlakna / 2); });
+        VelkeCislo pravy = soucin_stromem(listy, stred, po, vlakna - vlakna / 2);
+        t.join();
+        return levy * pravy;
+    }
+    return soucin_stromem(listy, od, stred, 1) * soucin_stromem(listy, stred, po, 1);
+}
+
+VelkeCislo soucin_presne(const std::vector<int> &cisla, const NastaveniParalelismu &nastaveni)
+{
+    // Rychlá cesta: absolutní hodnoty se násobí ve 128 bitech. Když by další
+    // násobení přeteklo, dosavadní mezivýsledek se uloží jako list stromu.
+    std::vector<VelkeCislo> listy;
+    unsigned __int128 mezivysledek = 1;
+    bool zaporne = false;
     for (int c : cisla) {
-        suma += c;
+        if (c == 0) {
+            return VelkeCislo(0);
+        }
+        zaporne ^= c < 0;
+        unsigned __int128 absolutni = c < 0 ? 0u - static_cast<unsigned int>(c) : static_cast<unsigned int>(c);
+        unsigned __int128 soucin;
+        if (__builtin_mul_overflow(mezivysledek, absolutni, &soucin)) {
+            listy.emplace_back();
+            listy.back().m_cislice = {static_cast<uint32_t>(mezivysledek), static_cast<uint32_t>(mezivysledek >> 32),
+                                      static_cast<uint32_t>(mezivysledek >> 64), static_cast<uint32_t>(mezivysledek >> 96)};
+            orizni(listy.back().m_cislice);
+            soucin = absolutni;
+        }
+        mezivysledek = soucin;
     }
-    return suma / cisla.size();
+    listy.emplace_back();
+    listy.back().m_cislice = {static_cast<uint32_t>(mezivysledek), static_cast<uint32_t>(mezivysledek >> 32),
+                              static_cast<uint32_t>(mezivysledek >> 64), static_cast<uint32_t>(mezivysledek >> 96)};
+    orizni(listy.back().m_cislice);
+
+    VelkeCislo vysledek = soucin_stromem(listy, 0, listy.size(), pocet_vlaken(cisla.size(), nastaveni));
+    vysledek.m_zaporne = zaporne;
+    return vysledek;
 }
 
-double median(const std::vector<int> &cisla)
+void PrubezneStatistiky::pridej(int hodnota)
 {
-    // TODO: Implementujte funkci
+    m_pocet++;
+    m_soucet += hodnota;
+    m_soucin *= static_cast<unsigned int>(hodnota);
 
-    std::vector<int> kopie = cisla;
-    std::sort(kopie.begin(), kopie.end());
+    // Hodnota jde do dolní nebo horní poloviny, poté se haldy vyrovnají tak,
+    // aby dolní měla stejně nebo o jeden prvek více než horní.
+    if (m_dolni.empty() || hodnota <= m_dolni.top()) {
+        m_dolni.push(hodnota);
+    } else {
+        m_horni.push(hodnota);
+    }
+
+    if (m_dolni.size() > m_horni.size() + 1) {
+        m_horni.push(m_dolni.top());
+        m_dolni.pop();
+    } else if (m_horni.size() > m_dolni.size()) {
+        m_dolni.push(m_horni.top());
+        m_horni.pop();
+    }
+}
+
+void PrubezneStatistiky::pridej(const std::vector<int> &hodnoty)
+{
+    for (int c : hodnoty) {
+        pridej(c);
+    }
+}
+
+double PrubezneStatistiky::prumer() const
+{
+    return static_cast<double>(m_soucet) / m_pocet;
+}
 
-    int n = kopie.size();
-    if (n % 2 == 1) {
+double PrubezneStatistiky::median() const
+{
+    if (m_pocet == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (m_dolni.size() > m_horni.size()) {
         // pokud je počet prvků lichý
-        return kopie[n / 2];
-    } else {
-        // pokud je počet prvků sudý
-        return (kopie[n / 2 - 1] + kopie[n / 2]) / 2.0;
+        return m_dolni.top();
+    }
+    // pokud je počet prvků sudý
+    return (static_cast<double>(m_dolni.top()) + m_horni.top()) / 2.0;
+}
+
+Statistiky PrubezneStatistiky::vysledek() const
+{
+    Statistiky s;
+    s.soucet = static_cast<int>(m_soucet);
+    s.soucin = static_cast<int>(m_soucin);
+    s.prumer = prumer();
+    s.median = median();
+    return s;
+}
+
+/**
+ * Najde první oddělovač (',' nebo '\n') v rozsahu [p, konec), jinak vrátí konec.
+ * Na x86 se porovnává 16 bajtů najednou (SSE2 je součástí základní sady x86-64).
+ */
+static const char *najdi_oddelovac(const char *p, const char *konec)
+{
+#if defined(__SSE2__)
+    const __m128i carka = _mm_set1_epi8(',');
+    const __m128i novy_radek = _mm_set1_epi8('\n');
+    for (; konec - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        int maska = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, carka),
+                                                   _mm_cmpeq_epi8(v, novy_radek)));
+        if (maska != 0) {
+            return p + __builtin_ctz(static_cast<unsigned int>(maska));
+        }
+    }
+#endif
+    while (p < konec && *p != ',' && *p != '\n') {
+        p++;
+    }
+    return p;
+}
+
+static bool je_mezera(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+size_t parsuj_cisla(const char *data, size_t delka, std::vector<int> &cisla,
+                    std::vector<ChybaParsovani> &chyby, size_t pocatecni_pozice)
+{
+    size_t nacteno = 0;
+    const char *konec = data + delka;
+    const char *p = data;
+    while (p < konec) {
+        const char *konec_pole = najdi_oddelovac(p, konec);
+
+        // Ořízneme mezery kolem čísla, prázdná pole přeskočíme
+        const char *a = p;
+        const char *b = konec_pole;
+        while (a < b && je_mezera(*a)) {
+            a++;
+        }
+        while (b > a && je_mezera(b[-1])) {
+            b--;
+        }
+        if (a < b) {
+            // from_chars nezná znaménko '+', std::stoi ano
+            const char *cislo = (*a == '+' && b - a > 1 && a[1] >= '0' && a[1] <= '9') ? a + 1 : a;
+            int hodnota;
+            std::from_chars_result r = std::from_chars(cislo, b, hodnota);
+            if (r.ec == std::errc() && r.ptr == b) {
+                cisla.push_back(hodnota);
+                nacteno++;
+            } else {
+                chyby.push_back({pocatecni_pozice + static_cast<size_t>(a - data), std::string(a, b)});
+            }
+        }
+        p = konec_pole + 1;
+    }
+    return nacteno;
+}
+
+bool nacti_cisla_ze_souboru(const std::string &cesta, std::vector<int> &cisla,
+                            std::vector<ChybaParsovani> &chyby)
+{
+#ifdef VYPOCTY_MMAP
+    int fd = open(cesta.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        // Běžný soubor se namapuje do paměti a parsuje přímo z mapovaných stránek
+        size_t delka = static_cast<size_t>(info.st_size);
+        if (delka == 0) {
+            close(fd);
+            return true;
+        }
+        void *mapa = mmap(nullptr, delka, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapa == MAP_FAILED) {
+            return false;
+        }
+        madvise(mapa, delka, MADV_SEQUENTIAL);
+        parsuj_cisla(static_cast<const char *>(mapa), delka, cisla, chyby);
+        munmap(mapa, delka);
+        return true;
+    }
+    close(fd);
+#endif
+    // Roura, zařízení nebo systém bez mmap - čteme jako proud
+    std::ifstream ifs(cesta, std::ios::in | std::ios::binary);
+    if (!ifs.is_open()) {
+        return false;
+    }
+    nacti_cisla_z_proudu(ifs, cisla, chyby);
+    return true;
+}
+
+void nacti_cisla_z_proudu(std::istream &vstup, std::vector<int> &cisla,
+                          std::vector<ChybaParsovani> &chyby)
+{
+    // Čte se po velkých blocích. Rozpracované pole na konci bloku se přesune
+    // na začátek bufferu a dokončí se s dalším blokem.
+    const size_t velikost_bloku = 1 << 20;
+    std::vector<char> buffer(velikost_bloku);
+    size_t zbytek = 0;  // bajty rozpracovaného pole na začátku bufferu
+    size_t pozice = 0;  // pozice začátku bufferu ve vstupu
+    while (true) {
+        if (buffer.size() - zbytek < velikost_bloku / 2) {
+            buffer.resize(buffer.size() * 2); // extrémně dlouhé pole
+        }
+        vstup.read(buffer.data() + zbytek, static_cast<std::streamsize>(buffer.size() - zbytek));
+        size_t platne = zbytek + static_cast<size_t>(vstup.gcount());
+        if (vstup.gcount() == 0) {
+            parsuj_cisla(buffer.data(), platne, cisla, chyby, pozice);
+            return;
+        }
+
+        size_t hotovo = platne;
+        while (hotovo > 0 && buffer[hotovo - 1] != ',' && buffer[hotovo - 1] != '\n') {
+            hotovo--;
+        }
+        parsuj_cisla(buffer.data(), hotovo, cisla, chyby, pozice);
+        zbytek = platne - hotovo;
+        std::memmove(buffer.data(), buffer.data() + hotovo, zbytek);
+        pozice += hotovo;
     }
 }
 
 #ifndef __TEST__
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1) {
+        // Velký vstup ze souboru: celý se načte (přes mmap) a spočítá najednou
+        std::vector<int> cisla;
+        std::vector<ChybaParsovani> chyby;
+        if (!nacti_cisla_ze_souboru(argv[1], cisla, chyby)) {
+            std::cerr << "Chyba: nepodařilo se otevřít soubor '" << argv[1] << "'." << std::endl;
+            return 1;
+        }
+        for (const ChybaParsovani &chyba : chyby) {
+            std::cerr << "Neplatné číslo '" << chyba.token << "' na pozici " << chyba.pozice << std::endl;
+        }
+
+        Statistiky vysledek = statistiky(cisla);
+        std::cout << "Součet: " << vysledek.soucet << std::endl;
+        std::cout << "Součin: " << vysledek.soucin << std::endl;
+        std::cout << "Průměrná hodnota: " << vysledek.prumer << std::endl;
+        std::cout << "Medián: " << vysledek.median << std::endl;
+        return 0;
+    }
+
     std::cout << "Zadejte seznam čísel oddělených čárkou: ";
-    std::string vstup;
-    std::getline(std::cin, vstup);
-
-    std::vector<int> cisla;
-    // TODO: Načtěte čísla ze vstupu do vektoru cisla
-    {
-        std::stringstream ss(vstup);
-        std::string hodnota;
-        while (std::getline(ss, hodnota, ',')) {
-            if (!hodnota.empty()) {
-                cisla.push_back(std::stoi(hodnota));
+
+    // Čísla se zpracovávají průběžně, jak přicházejí na vstup - celý řádek ani
+    // vektor všech hodnot se neukládá. Po každém řádku se vypíše aktuální stav,
+    // takže lze na vstup přesměrovat i nekonečný proud hodnot.
+    PrubezneStatistiky prubezne;
+    std::string hodnota;
+    std::vector<int> pole;
+    std::vector<ChybaParsovani> chyby;
+    size_t pozice = 0;
+    char znak;
+    bool konec = false;
+    bool nove_hodnoty = false;
+    while (!konec) {
+        konec = !std::cin.get(znak);
+        if (!konec && znak != ',' && znak != '\n') {
+            hodnota.push_back(znak);
+            pozice++;
+            continue;
+        }
+        if (!hodnota.empty()) {
+            pole.clear();
+            parsuj_cisla(hodnota.data(), hodnota.size(), pole, chyby, pozice - hodnota.size());
+            for (const ChybaParsovani &chyba : chyby) {
+                std::cerr << "Neplatné číslo '" << chyba.token << "' na pozici " << chyba.pozice << std::endl;
             }
+            chyby.clear();
+            if (!pole.empty()) {
+                prubezne.pridej(pole[0]);
+                nove_hodnoty = true;
+            }
+            hodnota.clear();
+        }
+        pozice++;
+        if ((konec || znak == '\n') && nove_hodnoty) {
+            nove_hodnoty = false;
+            Statistiky vysledek = prubezne.vysledek();
+            std::cout << "Součet: " << vysledek.soucet << std::endl;
+            std::cout << "Součin: " << vysledek.soucin << std::endl;
+            std::cout << "Průměrná hodnota: " << vysledek.prumer << std::endl;
+            std::cout << "Medián: " << vysledek.median << std::endl;
         }
     }
 
-    std::cout << "Součet: " << soucet(cisla) << std::endl;
-    std::cout << "Součin: " << soucin(cisla) << std::endl;
-    std::cout << "Průměrná hodnota: " << prumer(cisla) << std::endl;
-    std::cout << "Medián: " << median(cisla) << std::endl;
-
     return 0;
 }
 #endif // __TEST__
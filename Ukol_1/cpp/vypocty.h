@@ -1,11 +1,371 @@
 #ifndef VYPOCTY_H
 #define VYPOCTY_H
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <set>
+#include <span>
+#include <string>
+#include <type_traits>
 #include <vector>
 
+// Výsledek součtu, součinu, průměru a mediánu spočítaný jedním voláním statistiky().
+struct Statistiky
+{
+    int soucet;
+    int soucin;
+    double prumer;
+    double median;
+};
+
 int soucet(const std::vector<int>& cisla);
 int soucin(const std::vector<int>& cisla);
 double prumer(const std::vector<int>& cisla);
 double median(const std::vector<int>& cisla);
+Statistiky statistiky(const std::vector<int>& cisla);
+
+// Obecné verze výpočtů pro libovolný aritmetický typ prvků, nad std::span nebo
+// rozsahem iterátorů (bez kopírování do std::vector<int>). Lze je volat i v constexpr.
+//
+// Celá čísla se sčítají v 64 bitech, reálná alespoň v double. Součin celých čísel
+// má šířku T a počítá se modulo 2^n stejně jako soucin pro int.
+template <typename T>
+using SoucetTyp = std::conditional_t<std::is_floating_point_v<T>, std::common_type_t<T, double>,
+                  std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+template <typename T>
+using SoucinTyp = std::conditional_t<std::is_floating_point_v<T>, std::common_type_t<T, double>, T>;
+template <typename T>
+using PrumerTyp = std::common_type_t<T, double>;
+
+// Vektorová jádra pro int (vypocty.cpp), obecné šablony je použijí mimo constexpr
+long long soucet_vektorove(const int* data, size_t n);
+unsigned int soucin_vektorove(const int* data, size_t n);
+
+template <std::input_iterator It>
+constexpr SoucetTyp<std::iter_value_t<It>> soucet(It prvni, It posledni)
+{
+    using T = std::iter_value_t<It>;
+    if constexpr (std::is_same_v<T, int> && std::contiguous_iterator<It>) {
+        if (!std::is_constant_evaluated()) {
+            return soucet_vektorove(std::to_address(prvni), static_cast<size_t>(posledni - prvni));
+        }
+    }
+    SoucetTyp<T> vysledek = 0;
+    for (; prvni != posledni; ++prvni) {
+        vysledek += *prvni;
+    }
+    return vysledek;
+}
+
+template <std::input_iterator It>
+constexpr SoucinTyp<std::iter_value_t<It>> soucin(It prvni, It posledni)
+{
+    using T = std::iter_value_t<It>;
+    if constexpr (std::is_floating_point_v<T>) {
+        SoucinTyp<T> vysledek = 1;
+        for (; prvni != posledni; ++prvni) {
+            vysledek *= *prvni;
+        }
+        return vysledek;
+    } else {
+        if constexpr (std::is_same_v<T, int> && std::contiguous_iterator<It>) {
+            if (!std::is_constant_evaluated()) {
+                return static_cast<int>(soucin_vektorove(std::to_address(prvni), static_cast<size_t>(posledni - prvni)));
+            }
+        }
+        // V unsigned long long je přetečení definované, dolní bity odpovídají šířce T
+        unsigned long long vysledek = 1;
+        for (; prvni != posledni; ++prvni) {
+            vysledek *= static_cast<unsigned long long>(*prvni);
+        }
+        return static_cast<T>(vysledek);
+    }
+}
+
+template <std::input_iterator It>
+constexpr PrumerTyp<std::iter_value_t<It>> prumer(It prvni, It posledni)
+{
+    using T = std::iter_value_t<It>;
+    if constexpr (std::forward_iterator<It>) {
+        auto n = std::distance(prvni, posledni);
+        return static_cast<PrumerTyp<T>>(soucet(prvni, posledni)) / n;
+    } else {
+        SoucetTyp<T> suma = 0;
+        size_t n = 0;
+        for (; prvni != posledni; ++prvni, ++n) {
+            suma += *prvni;
+        }
+        return static_cast<PrumerTyp<T>>(suma) / n;
+    }
+}
+
+// Medián výběrem (nth_element) v průměrném čase O(n); přeuspořádá prvky data.
+// Pro prázdný vstup vrací NaN (stejně jako prumer).
+template <typename T>
+constexpr PrumerTyp<T> median_na_miste(std::span<T> data)
+{
+    size_t n = data.size();
+    if (n == 0) {
+        return std::numeric_limits<PrumerTyp<T>>::quiet_NaN();
+    }
+
+    auto stred = data.begin() + n / 2;
+    std::nth_element(data.begin(), stred, data.end());
+    if (n % 2 == 1) {
+        // pokud je počet prvků lichý
+        return *stred;
+    }
+    // pokud je počet prvků sudý - levý prostřední prvek je maximum levé poloviny
+    T levy = *std::max_element(data.begin(), stred);
+    return (static_cast<PrumerTyp<T>>(levy) + *stred) / 2;
+}
+
+template <std::input_iterator It>
+constexpr PrumerTyp<std::iter_value_t<It>> median(It prvni, It posledni)
+{
+    std::vector<std::iter_value_t<It>> kopie(prvni, posledni);
+    return median_na_miste<std::iter_value_t<It>>(kopie);
+}
+
+template <typename T, size_t N>
+constexpr SoucetTyp<std::remove_cv_t<T>> soucet(std::span<T, N> cisla)
+{
+    return soucet(cisla.begin(), cisla.end());
+}
+
+template <typename T, size_t N>
+constexpr SoucinTyp<std::remove_cv_t<T>> soucin(std::span<T, N> cisla)
+{
+    return soucin(cisla.begin(), cisla.end());
+}
+
+template <typename T, size_t N>
+constexpr PrumerTyp<std::remove_cv_t<T>> prumer(std::span<T, N> cisla)
+{
+    return prumer(cisla.begin(), cisla.end());
+}
+
+template <typename T, size_t N>
+constexpr PrumerTyp<std::remove_cv_t<T>> median(std::span<T, N> cisla)
+{
+    return median(cisla.begin(), cisla.end());
+}
+
+// Průběžné statistiky pro data, která přicházejí postupně (proud hodnot).
+// Součet, součin a průměr se udržují v O(1) paměti, přesný medián ve dvou haldách
+// (dolní polovina v max-haldě, horní v min-haldě), vložení stojí O(log n).
+class PrubezneStatistiky
+{
+public:
+    void pridej(int hodnota);
+    void pridej(const std::vector<int>& hodnoty);
+
+    size_t pocet() const { return m_pocet; }
+    long long soucet() const { return m_soucet; }
+    double prumer() const;
+    double median() const;
+
+    // Aktuální stav kdykoli během příjmu dat
+    Statistiky vysledek() const;
+
+private:
+    size_t m_pocet = 0;
+    long long m_soucet = 0;
+    unsigned int m_soucin = 1;
+    std::priority_queue<int> m_dolni;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> m_horni;
+};
+
+// Nastavení vícevláknových výpočtů
+struct NastaveniParalelismu
+{
+    unsigned int vlakna = 0;   // 0 = podle počtu jader (std::thread::hardware_concurrency)
+    size_t prah = 1 << 20;     // vstupy kratší než prah se počítají v jednom vlákně
+};
+
+int soucet_paralelne(const std::vector<int>& cisla, const NastaveniParalelismu& nastaveni = {});
+int soucin_paralelne(const std::vector<int>& cisla, const NastaveniParalelismu& nastaveni = {});
+double prumer_paralelne(const std::vector<int>& cisla, const NastaveniParalelismu& nastaveni = {});
+double median_paralelne(const std::vector<int>& cisla, const NastaveniParalelismu& nastaveni = {});
+
+// Celé číslo s libovolnou přesností: znaménko a absolutní hodnota v číslicích
+// o základu 2^32 (od nejnižší, bez úvodních nul; nula nemá žádné číslice).
+class VelkeCislo
+{
+public:
+    VelkeCislo(long long hodnota = 0);
+
+    bool je_nula() const { return m_cislice.empty(); }
+    bool zaporne() const { return m_zaporne; }
+    const std::vector<uint32_t>& cislice() const { return m_cislice; }
+
+    // Pro velká čísla (desítky číslic a víc) násobí Karatsubovým algoritmem
+    VelkeCislo operator*(const VelkeCislo& b) const;
+    bool operator==(const VelkeCislo& b) const = default;
+
+    std::string na_retezec() const; // desítkový zápis
+
+private:
+    bool m_zaporne = false;
+    std::vector<uint32_t> m_cislice;
+
+    friend VelkeCislo soucin_presne(const std::vector<int>& cisla, const NastaveniParalelismu& nastaveni);
+};
+
+std::ostream& operator<<(std::ostream& os, const VelkeCislo& cislo);
+
+// Přesný součin bez přetečení. Dokud se mezivýsledek vejde do 128 bitů, násobí se
+// přímo; jinak se součiny 128bitových úseků násobí vyváženým stromem, jehož
+// podstromy běží paralelně.
+VelkeCislo soucin_presne(const std::vector<int>& cisla, const NastaveniParalelismu& nastaveni = {});
+
+// Setříděný pohled na data: jednou setřídí kopii a pak odpovídá na opakované dotazy
+// (medián, libovolný kvantil, počet hodnot pod x) bez dalšího třídění.
+// Nová data se přidávají slitím setříděné dávky se stávajícími daty, ne novým tříděním.
+class SerazenyPohled
+{
+public:
+    SerazenyPohled() = default;
+    explicit SerazenyPohled(const std::vector<int>& cisla);
+
+    size_t pocet() const { return m_data.size(); }
+    const std::vector<int>& data() const { return m_data; }
+
+    // O(1). Kvantil p z [0, 1] s lineární interpolací, kvantil(0.5) == median().
+    // Pro p mimo [0, 1] hází std::invalid_argument, pro prázdná data vrací NaN.
+    double kvantil(double p) const;
+    double median() const { return kvantil(0.5); }
+
+    // O(log n). Počet hodnot menších než hodnota, resp. menších nebo rovných.
+    size_t pocet_mensich(int hodnota) const;
+    size_t pocet_nejvyse(int hodnota) const;
+
+    // Dávka se setřídí (O(k log k)) a slije se stávajícími daty (O(n + k))
+    void pridej(const std::vector<int>& davka);
+    // Jedna hodnota se vloží na své místo posunem (O(n))
+    void pridej(int hodnota);
+
+private:
+    std::vector<int> m_data;
+};
+
+// Klouzavé okno přes posledních sirka hodnot proudu. Součet a průměr se
+// aktualizují v O(1), medián v O(log sirka) pomocí dvou multimnožin
+// (dolní a horní polovina okna).
+class KlouzaveOkno
+{
+public:
+    // Pro sirka = 0 hází std::invalid_argument
+    explicit KlouzaveOkno(size_t sirka);
+
+    // Přidá hodnotu; je-li okno plné, vypadne z něj nejstarší hodnota
+    void pridej(int hodnota);
+
+    size_t sirka() const { return m_sirka; }
+    size_t pocet() const { return m_pocet; }
+    bool plne() const { return m_pocet == m_sirka; }
+    long long soucet() const { return m_soucet; }
+    double prumer() const;
+    double median() const;
+
+private:
+    void vyrovnej();
+
+    size_t m_sirka;
+    size_t m_pocet = 0;
+    size_t m_nejstarsi = 0;     // index nejstarší hodnoty v kruhovém bufferu
+    std::vector<int> m_okno;    // kruhový buffer s hodnotami v pořadí příchodu
+    long long m_soucet = 0;
+    std::multiset<int> m_dolni; // menší polovina, má stejně nebo o jeden prvek víc
+    std::multiset<int> m_horni;
+};
+
+// Slučitelný kvantilový náčrt (KLL) pro přibližný medián a kvantily nad daty
+// rozdělenými mezi více vláken, procesů či strojů. Náčrt má velikost O(k) bez ohledu
+// na počet hodnot, chyba pořadí vráceného kvantilu je zhruba 1.7 / k * počet.
+// Počet, součet, minimum a maximum jsou přesné a slučují se spolu s náčrtem.
+class KvantilovyNacrt
+{
+public:
+    explicit KvantilovyNacrt(uint32_t k = 200);
+
+    // Náčrt dat postavený paralelně: každé vlákno zpracuje svůj úsek, výsledky se slijí
+    static KvantilovyNacrt z_dat(std::span<const int> cisla, uint32_t k = 200,
+                                 const NastaveniParalelismu& nastaveni = {});
+
+    void pridej(int hodnota);
+    void sluc(const KvantilovyNacrt& jiny);
+
+    uint64_t pocet() const { return m_pocet; }
+    long long soucet() const { return m_soucet; }
+    double prumer() const;
+    int minimum() const { return m_minimum; }
+    int maximum() const { return m_maximum; }
+
+    // Přibližný kvantil p z [0, 1]; pro p mimo interval hází std::invalid_argument,
+    // pro prázdný náčrt vrací NaN
+    double kvantil(double p) const;
+    double median() const { return kvantil(0.5); }
+
+    // Binární formát (little-endian) pro přenos mezi uzly; deserializuj hází
+    // std::invalid_argument pro poškozená data
+    std::vector<unsigned char> serializuj() const;
+    static KvantilovyNacrt deserializuj(const unsigned char* data, size_t delka);
+
+    size_t velikost() const; // počet uložených hodnot ve všech úrovních
+
+private:
+    size_t kapacita(size_t uroven) const;
+    void zhustit();
+
+    uint32_t m_k;
+    uint64_t m_pocet = 0;
+    long long m_soucet = 0;
+    int m_minimum = std::numeric_limits<int>::max();
+    int m_maximum = std::numeric_limits<int>::min();
+    uint64_t m_nahoda = 0x9E3779B97F4A7C15ULL; // stav generátoru pro výběr sudých/lichých
+    // Hodnota na úrovni h zastupuje 2^h původních hodnot
+    std::vector<std::vector<int>> m_urovne;
+};
+
+// Výsledky pro mnoho krátkých řad najednou, jedna položka na řadu
+struct DavkoveStatistiky
+{
+    std::vector<long long> soucty;
+    std::vector<double> prumery;
+    std::vector<double> mediany;
+};
+
+// Řady jsou uloženy za sebou v jednom poli hodnoty (formát CSR): řada i zabírá
+// hodnoty[offsety[i] .. offsety[i + 1]). Pro neplatné offsety hází std::invalid_argument.
+DavkoveStatistiky davkove_statistiky(std::span<const int> hodnoty, std::span<const size_t> offsety,
+                                     const NastaveniParalelismu& nastaveni = {});
+
+// Statistiky všech plných oken šířky sirka nad polem cisla (cisla.size() - sirka + 1
+// výsledků; žádný, je-li pole kratší). Výsledky se vrací ve stejné struktuře jako
+// davkove_statistiky, jedna položka na okno.
+DavkoveStatistiky klouzave_statistiky(std::span<const int> cisla, size_t sirka);
+
+// Neplatný token ve vstupu: bajtová pozice jeho začátku a jeho text
+struct ChybaParsovani
+{
+    size_t pozice;
+    std::string token;
+};
+
+// Načítání čísel oddělených čárkou (nebo koncem řádku) bez alokace pro každé pole.
+// Platná čísla se připojí do cisla, neplatné tokeny do chyby; prázdná pole se přeskočí.
+size_t parsuj_cisla(const char* data, size_t delka, std::vector<int>& cisla,
+                    std::vector<ChybaParsovani>& chyby, size_t pocatecni_pozice = 0);
+bool nacti_cisla_ze_souboru(const std::string& cesta, std::vector<int>& cisla,
+                            std::vector<ChybaParsovani>& chyby);
+void nacti_cisla_z_proudu(std::istream& vstup, std::vector<int>& cisla,
+                          std::vector<ChybaParsovani>& chyby);
 
 #endif // VYPOCTY_H
@@ -0,0 +1,366 @@
+#include "kryptoanalyza.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KRYPTOANALYZA_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+const RozlozeniPismen CESTINA = {
+    0.089, 0.016, 0.028, 0.036, 0.105, 0.003, 0.003, 0.013, 0.071, 0.021, 0.037, 0.038, 0.032,
+    0.066, 0.087, 0.034, 0.0001, 0.048, 0.058, 0.058, 0.030, 0.043, 0.0002, 0.0003, 0.028, 0.031};
+
+const RozlozeniPismen ANGLICTINA = {
+    0.082, 0.015, 0.028, 0.043, 0.127, 0.022, 0.020, 0.061, 0.070, 0.0015, 0.0077, 0.040, 0.024,
+    0.067, 0.075, 0.019, 0.00095, 0.060, 0.063, 0.091, 0.028, 0.0098, 0.024, 0.0015, 0.020, 0.00074};
+
+/**
+ * Histogram písmen. Skalární verze střídá čtyři dílčí histogramy, aby po sobě
+ * jdoucí stejná písmena nečekala na zápis do stejného počítadla.
+ */
+static std::array<uint64_t, 26> histogram_skalar(const char *data, size_t n)
+{
+    uint64_t dilci[4][26] = {};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        for (size_t k = 0; k < 4; k++)
+        {
+            unsigned int t = static_cast<unsigned char>(data[i + k] | 0x20) - 'a';
+            if (t < 26)
+            {
+                dilci[k][t]++;
+            }
+        }
+    }
+    for (; i < n; i++)
+    {
+        unsigned int t = static_cast<unsigned char>(data[i] | 0x20) - 'a';
+        if (t < 26)
+        {
+            dilci[0][t]++;
+        }
+    }
+
+    std::array<uint64_t, 26> histogram = {};
+    for (size_t t = 0; t < 26; t++)
+    {
+        histogram[t] = dilci[0][t] + dilci[1][t] + dilci[2][t] + dilci[3][t];
+    }
+    return histogram;
+}
+
+#ifdef KRYPTOANALYZA_X86_SIMD
+/**
+ * AVX2: pro každé písmeno porovnání celého 32bajtového bloku a přičtení shod
+ * do bajtových počítadel. Ta se nejpozději po 255 blocích (než přetečou)
+ * sečtou přes _mm256_sad_epu8 do 64bitových součtů.
+ */
+__attribute__((target("avx2"))) static std::array<uint64_t, 26> histogram_avx2(const char *data, size_t n)
+{
+    std::array<uint64_t, 26> histogram = {};
+    const __m256i velka_na_mala = _mm256_set1_epi8(0x20);
+    const __m256i nula = _mm256_setzero_si256();
+    size_t i = 0;
+    while (i + 32 <= n)
+    {
+        __m256i pocitadla[26];
+        for (int t = 0; t < 26; t++)
+        {
+            pocitadla[t] = nula;
+        }
+        size_t konec = std::min(n - n % 32, i + 255 * 32);
+        for (; i < konec; i += 32)
+        {
+            __m256i v = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), velka_na_mala);
+            for (int t = 0; t < 26; t++)
+            {
+                // Shoda dává 0xFF = -1, odečtení tedy přičte jedničku
+                __m256i shoda = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>('a' + t)));
+                pocitadla[t] = _mm256_sub_epi8(pocitadla[t], shoda);
+            }
+        }
+        for (int t = 0; t < 26; t++)
+        {
+            __m256i soucty = _mm256_sad_epu8(pocitadla[t], nula);
+            histogram[t] += static_cast<uint64_t>(_mm256_extract_epi64(soucty, 0)) +
+                            static_cast<uint64_t>(_mm256_extract_epi64(soucty, 1)) +
+                            static_cast<uint64_t>(_mm256_extract_epi64(soucty, 2)) +
+                            static_cast<uint64_t>(_mm256_extract_epi64(soucty, 3));
+        }
+    }
+    std::array<uint64_t, 26> zbytek = histogram_skalar(data + i, n - i);
+    for (int t = 0; t < 26; t++)
+    {
+        histogram[t] += zbytek[t];
+    }
+    return histogram;
+}
+#endif // KRYPTOANALYZA_X86_SIMD
+
+std::array<uint64_t, 26> histogram_pismen(std::span<const char> text)
+{
+    typedef std::array<uint64_t, 26> (*HistogramJadro)(const char *, size_t);
+    static const HistogramJadro jadro = []() -> HistogramJadro {
+#ifdef KRYPTOANALYZA_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return histogram_avx2;
+        }
+#endif
+        return histogram_skalar;
+    }();
+    return jadro(text.data(), text.size());
+}
+
+double chi_kvadrat(const std::array<uint64_t, 26> &histogram, unsigned int posun, const RozlozeniPismen &rozlozeni)
+{
+    uint64_t n = 0;
+    double soucet_rozlozeni = 0;
+    for (size_t t = 0; t < 26; t++)
+    {
+        n += histogram[t];
+        soucet_rozlozeni += rozlozeni[t];
+    }
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    double chi = 0;
+    for (size_t t = 0; t < 26; t++)
+    {
+        // Písmeno t otevřeného textu je v šifrovaném textu jako t + posun
+        double ocekavano = static_cast<double>(n) * std::max(rozlozeni[t] / soucet_rozlozeni, 1e-5);
+        double rozdil = static_cast<double>(histogram[(t + posun) % 26]) - ocekavano;
+        chi += rozdil * rozdil / ocekavano;
+    }
+    return chi;
+}
+
+double index_koincidence(const std::array<uint64_t, 26> &histogram)
+{
+    uint64_t n = 0;
+    double shody = 0;
+    for (uint64_t pocet : histogram)
+    {
+        n += pocet;
+        shody += static_cast<double>(pocet) * static_cast<double>(pocet > 0 ? pocet - 1 : 0);
+    }
+    if (n < 2)
+    {
+        return 0;
+    }
+    return shody / (static_cast<double>(n) * static_cast<double>(n - 1));
+}
+
+/**
+ * Spustí ukol(i) pro i = 0..vlakna-1 každý ve vlastním vlákně.
+ */
+static void spust_ve_vlaknech(unsigned int vlakna, const std::function<void(unsigned int)> &ukol)
+{
+    std::vector<std::thread> bezici;
+    for (unsigned int i = 1; i < vlakna; i++)
+    {
+        bezici.emplace_back(ukol, i);
+    }
+    ukol(0);
+    for (std::thread &vlakno : bezici)
+    {
+        vlakno.join();
+    }
+}
+
+static std::span<const char> vzorek(std::span<const char> text, size_t max_vzorek)
+{
+    return text.first(std::min(text.size(), max_vzorek));
+}
+
+std::vector<KandidatCaesar> prolom_caesar(std::span<const char> text, const RozlozeniPismen &rozlozeni, size_t max_vzorek)
+{
+    std::array<uint64_t, 26> histogram = histogram_pismen(vzorek(text, max_vzorek));
+    std::vector<KandidatCaesar> kandidati;
+    for (unsigned int posun = 0; posun < 26; posun++)
+    {
+        kandidati.push_back({static_cast<int>(posun), chi_kvadrat(histogram, posun, rozlozeni)});
+    }
+    std::stable_sort(kandidati.begin(), kandidati.end(),
+                     [](const KandidatCaesar &a, const KandidatCaesar &b) { return a.skore < b.skore; });
+    return kandidati;
+}
+
+/**
+ * Histogramy sloupců: písmeno na pozici i (počítáno jen mezi písmeny) patří do sloupce i % delka.
+ */
+static std::vector<std::array<uint64_t, 26>> histogramy_sloupcu(const std::vector<unsigned char> &pismena, size_t delka)
+{
+    std::vector<std::array<uint64_t, 26>> sloupce(delka, std::array<uint64_t, 26>{});
+    size_t j = 0;
+    for (unsigned char t : pismena)
+    {
+        sloupce[j][t]++;
+        if (++j == delka)
+        {
+            j = 0;
+        }
+    }
+    return sloupce;
+}
+
+/**
+ * Kasiského test: vzdálenosti opakovaných trigramů bývají násobky délky klíče.
+ * Vrací pro každou délku počet vzdáleností, které dělí, vynásobený délkou
+ * (u náhodných vzdáleností je počet úměrný 1/délka, tím se to vyrovná).
+ */
+static std::vector<double> kasiski(const std::vector<unsigned char> &pismena, size_t max_delka)
+{
+    const size_t MAX_PISMEN = 1 << 16;
+    std::vector<double> skore(max_delka + 1, 0);
+    std::vector<int64_t> posledni(26 * 26 * 26, -1);
+    size_t n = std::min(pismena.size(), MAX_PISMEN);
+    for (size_t i = 0; i + 3 <= n; i++)
+    {
+        size_t trigram = (pismena[i] * 26u + pismena[i + 1]) * 26u + pismena[i + 2];
+        if (posledni[trigram] >= 0)
+        {
+            size_t vzdalenost = i - static_cast<size_t>(posledni[trigram]);
+            for (size_t delka = 2; delka <= max_delka; delka++)
+            {
+                if (vzdalenost % delka == 0)
+                {
+                    skore[delka] += static_cast<double>(delka);
+                }
+            }
+        }
+        posledni[trigram] = static_cast<int64_t>(i);
+    }
+    return skore;
+}
+
+/**
+ * Nejkratší perioda klíče, např. "abcabc" -> "abc".
+ */
+static std::string nejkratsi_perioda(const std::string &klic)
+{
+    for (size_t p = 1; p < klic.size(); p++)
+    {
+        if (klic.size() % p != 0)
+        {
+            continue;
+        }
+        bool periodicky = true;
+        for (size_t i = p; i < klic.size() && periodicky; i++)
+        {
+            periodicky = klic[i] == klic[i - p];
+        }
+        if (periodicky)
+        {
+            return klic.substr(0, p);
+        }
+    }
+    return klic;
+}
+
+std::vector<KandidatVigener> prolom_vigener(std::span<const char> text, size_t max_delka_klice, size_t pocet_kandidatu,
+                                            unsigned int vlakna, const RozlozeniPismen &rozlozeni, size_t max_vzorek)
+{
+    // Posun klíče se posouvá jen na písmenech, analyzujeme proto jen je (0..25)
+    std::vector<unsigned char> pismena;
+    for (char c : vzorek(text, max_vzorek))
+    {
+        unsigned int t = static_cast<unsigned char>(c | 0x20) - 'a';
+        if (t < 26)
+        {
+            pismena.push_back(static_cast<unsigned char>(t));
+        }
+    }
+    max_delka_klice = std::min(max_delka_klice, pismena.size());
+    if (max_delka_klice == 0 || pocet_kandidatu == 0)
+    {
+        return {};
+    }
+
+    if (vlakna == 0)
+    {
+        vlakna = std::max(1u, std::thread::hardware_concurrency());
+    }
+    vlakna = static_cast<unsigned int>(std::min<size_t>(vlakna, max_delka_klice));
+
+    // 1) Průměrný index koincidence sloupců pro každou délku; délky si vlákna dělí střídavě
+    std::vector<double> koincidence(max_delka_klice + 1, 0);
+    spust_ve_vlaknech(vlakna, [&](unsigned int i) {
+        for (size_t delka = 1 + i; delka <= max_delka_klice; delka += vlakna)
+        {
+            double soucet = 0;
+            for (const std::array<uint64_t, 26> &sloupec : histogramy_sloupcu(pismena, delka))
+            {
+                soucet += index_koincidence(sloupec);
+            }
+            koincidence[delka] = soucet / static_cast<double>(delka);
+        }
+    });
+
+    // 2) Kandidátní délky: nejlepší podle koincidence a podle Kasiského testu
+    std::vector<size_t> delky(max_delka_klice);
+    for (size_t i = 0; i < delky.size(); i++)
+    {
+        delky[i] = i + 1;
+    }
+    std::stable_sort(delky.begin(), delky.end(), [&](size_t a, size_t b) { return koincidence[a] > koincidence[b]; });
+    delky.resize(std::min(delky.size(), pocet_kandidatu));
+
+    std::vector<double> kasiskeho = kasiski(pismena, max_delka_klice);
+    size_t nejlepsi_kasiski = static_cast<size_t>(std::max_element(kasiskeho.begin(), kasiskeho.end()) - kasiskeho.begin());
+    if (kasiskeho[nejlepsi_kasiski] > 0 && std::find(delky.begin(), delky.end(), nejlepsi_kasiski) == delky.end())
+    {
+        delky.push_back(nejlepsi_kasiski);
+    }
+
+    // 3) Klíč pro každou kandidátní délku: v každém sloupci posun s nejmenším chí-kvadrátem
+    std::vector<KandidatVigener> kandidati(delky.size());
+    unsigned int vlakna_klicu = static_cast<unsigned int>(std::min<size_t>(vlakna, delky.size()));
+    spust_ve_vlaknech(vlakna_klicu, [&](unsigned int i) {
+        for (size_t k = i; k < delky.size(); k += vlakna_klicu)
+        {
+            KandidatVigener &kandidat = kandidati[k];
+            kandidat.skore = 0;
+            for (const std::array<uint64_t, 26> &sloupec : histogramy_sloupcu(pismena, delky[k]))
+            {
+                unsigned int nejlepsi = 0;
+                double nejmensi = chi_kvadrat(sloupec, 0, rozlozeni);
+                for (unsigned int posun = 1; posun < 26; posun++)
+                {
+                    double chi = chi_kvadrat(sloupec, posun, rozlozeni);
+                    if (chi < nejmensi)
+                    {
+                        nejmensi = chi;
+                        nejlepsi = posun;
+                    }
+                }
+                kandidat.klic.push_back(static_cast<char>('a' + nejlepsi));
+                kandidat.skore += nejmensi;
+            }
+            kandidat.skore /= static_cast<double>(pismena.size());
+            kandidat.klic = nejkratsi_perioda(kandidat.klic);
+        }
+    });
+
+    // 4) Seřazení a sloučení stejných klíčů (násobky délky dávají opakovaný klíč)
+    std::stable_sort(kandidati.begin(), kandidati.end(),
+                     [](const KandidatVigener &a, const KandidatVigener &b) { return a.skore < b.skore; });
+    std::vector<KandidatVigener> vysledek;
+    for (const KandidatVigener &kandidat : kandidati)
+    {
+        bool uz_je = std::any_of(vysledek.begin(), vysledek.end(),
+                                 [&](const KandidatVigener &k) { return k.klic == kandidat.klic; });
+        if (!uz_je && vysledek.size() < pocet_kandidatu)
+        {
+            vysledek.push_back(kandidat);
+        }
+    }
+    return vysledek;
+}
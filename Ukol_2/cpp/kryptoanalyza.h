@@ -0,0 +1,78 @@
+#ifndef KRYPTOANALYZA_H
+#define KRYPTOANALYZA_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Hledání ztraceného klíče k textům zašifrovaným caesar_sifra a vigener_sifra.
+ *
+ * Obě šifry posouvají jen písmena [A-Za-z], velikost písmen se při analýze
+ * neliší. Z velkých vstupů se analyzuje jen začátek o velikosti max_vzorek bajtů
+ * (u Vigenera musí vzorek začínat na začátku textu, aby klíč začínal správným písmenem).
+ */
+
+/** Relativní četnosti písmen a..z v jazyce textu (součet nemusí být přesně 1). */
+typedef std::array<double, 26> RozlozeniPismen;
+
+/** Četnosti písmen v češtině bez diakritiky (á -> a, č -> c, ...). */
+extern const RozlozeniPismen CESTINA;
+
+/** Četnosti písmen v angličtině. */
+extern const RozlozeniPismen ANGLICTINA;
+
+/** Výchozí velikost vzorku: na spolehlivý odhad klíče stačí stovky kB textu. */
+const size_t VYCHOZI_VZOREK = 1 << 20;
+
+/**
+ * Četnosti písmen a..z (velká i malá dohromady) v textu.
+ */
+std::array<uint64_t, 26> histogram_pismen(std::span<const char> text);
+
+/**
+ * Chí-kvadrát statistika: jak moc histogram (posunutý o posun) neodpovídá
+ * očekávanému rozložení. Menší = lepší shoda.
+ */
+double chi_kvadrat(const std::array<uint64_t, 26> &histogram, unsigned int posun, const RozlozeniPismen &rozlozeni);
+
+/**
+ * Index koincidence: pravděpodobnost, že dvě náhodně vybraná písmena jsou stejná.
+ * Přirozený text má kolem 0,06, rovnoměrně náhodný 1/26 ≈ 0,038.
+ */
+double index_koincidence(const std::array<uint64_t, 26> &histogram);
+
+struct KandidatCaesar
+{
+    int posun;     // caesar_sifra(text, posun, false) text dešifruje, 0..25
+    double skore;  // chí-kvadrát, menší = pravděpodobnější
+};
+
+/**
+ * Všech 26 posunů seřazených od nejpravděpodobnějšího.
+ */
+std::vector<KandidatCaesar> prolom_caesar(std::span<const char> text, const RozlozeniPismen &rozlozeni = CESTINA,
+                                          size_t max_vzorek = VYCHOZI_VZOREK);
+
+struct KandidatVigener
+{
+    std::string klic;  // malými písmeny; vigener_sifra(text, klic, false) text dešifruje
+    double skore;      // průměrný chí-kvadrát na písmeno, menší = pravděpodobnější
+};
+
+/**
+ * Délky klíče 1..max_delka_klice se ohodnotí indexem koincidence (paralelně ve
+ * vláknech, 0 = podle počtu jader), ke kandidátům se přidají délky podle Kasiského
+ * testu (vzdálenosti opakovaných trigramů). Pro nejlepší délky se klíč určí po
+ * sloupcích chí-kvadrátem. Klíče, které jsou jen opakováním kratšího klíče, se
+ * sloučí. Vrací nejvýše pocet_kandidatu klíčů seřazených od nejpravděpodobnějšího.
+ */
+std::vector<KandidatVigener> prolom_vigener(std::span<const char> text, size_t max_delka_klice = 32,
+                                            size_t pocet_kandidatu = 5, unsigned int vlakna = 0,
+                                            const RozlozeniPismen &rozlozeni = CESTINA,
+                                            size_t max_vzorek = VYCHOZI_VZOREK);
+
+#endif // KRYPTOANALYZA_H
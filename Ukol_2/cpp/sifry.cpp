@@ -3,181 +3,2337 @@
 #include <string>
 #include <cctype>  // kvůli isalpha, isupper, tolower atd.
 #include <algorithm> // kvůli std::transform
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "kryptoanalyza.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SIFRY_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <cerrno>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define SIFRY_IO_URING 1
+#endif
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIFRY_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Běžný soubor namapovaný do paměti jen pro čtení. Pokud soubor nejde namapovat
+ * (roura, zařízení, soubor v /proc s nulovou velikostí, systém bez mmap),
+ * namapovano() vrací false a volající použije čtení přes proud.
+ */
+class MapovanySoubor
+{
+public:
+    explicit MapovanySoubor(const std::string &jmeno_souboru)
+    {
+#ifdef SIFRY_MMAP
+        int fd = open(jmeno_souboru.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return;
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+        {
+            void *mapa = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapa != MAP_FAILED)
+            {
+                m_data = static_cast<const char *>(mapa);
+                m_velikost = static_cast<size_t>(info.st_size);
+                m_zarizeni = info.st_dev;
+                m_inode = info.st_ino;
+                // Čte se jednou od začátku do konce - jádro může číst dopředu
+                madvise(mapa, m_velikost, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    ~MapovanySoubor()
+    {
+#ifdef SIFRY_MMAP
+        if (m_data != nullptr)
+        {
+            munmap(const_cast<char *>(m_data), m_velikost);
+        }
+#endif
+    }
+
+    MapovanySoubor(const MapovanySoubor &) = delete;
+    MapovanySoubor &operator=(const MapovanySoubor &) = delete;
+
+    bool namapovano() const { return m_data != nullptr; }
+    const char *data() const { return m_data; }
+    size_t velikost() const { return m_velikost; }
+
+#ifdef SIFRY_MMAP
+    /** Je namapovaný soubor stejný (tentýž inode) jako otevřený soubor popsaný info? */
+    bool stejny_soubor(const struct stat &info) const
+    {
+        return m_data != nullptr && info.st_dev == m_zarizeni && info.st_ino == m_inode;
+    }
+#endif
+
+private:
+    const char *m_data = nullptr;
+    size_t m_velikost = 0;
+#ifdef SIFRY_MMAP
+    dev_t m_zarizeni = 0;
+    ino_t m_inode = 0;
+#endif
+};
+
+#ifdef SIFRY_MMAP
+/**
+ * Vyhradí souboru místo na disku pro velikost bajtů (a nastaví mu tuto délku).
+ * Bez vyhrazení by ftruncate vytvořil řídký soubor a při plném disku by zápis
+ * do namapovaných stránek skončil signálem SIGBUS místo ošetřitelné chyby.
+ */
+static bool vyhrad_misto(int fd, size_t velikost)
+{
+#if defined(__APPLE__)
+    // macOS nemá posix_fallocate, výstup se zapíše přes proud
+    (void)fd;
+    (void)velikost;
+    return false;
+#else
+    return posix_fallocate(fd, 0, static_cast<off_t>(velikost)) == 0;
+#endif
+}
+#endif
+
+/**
+ * Výstupní soubor předem zvětšený na danou velikost (s vyhrazeným místem na disku)
+ * a namapovaný pro zápis, takže šifra zapisuje přímo do stránek cílového souboru.
+ * Pokud mapování nejde vytvořit (např. chybí místo na disku), namapovano() vrací
+ * false a volající použije zápis přes proud. Je-li výstup stejný soubor jako
+ * namapovaný vstup zdroj, soubor se nezkrátí a stejny_jako_vstup() vrací true.
+ */
+class MapovanyVystup
+{
+public:
+    MapovanyVystup(const std::string &jmeno_souboru, size_t velikost, const MapovanySoubor *zdroj = nullptr)
+    {
+#ifdef SIFRY_MMAP
+        if (velikost == 0)
+        {
+            return;
+        }
+        // Bez O_TRUNC: soubor se zkrátí až po kontrole, že to není vstup
+        int fd = open(jmeno_souboru.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+        {
+            return;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            close(fd);
+            return;
+        }
+        if (zdroj != nullptr && zdroj->stejny_soubor(info))
+        {
+            m_stejny_jako_vstup = true;
+        }
+        else if (ftruncate(fd, 0) == 0 && vyhrad_misto(fd, velikost))
+        {
+            void *mapa = mmap(nullptr, velikost, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapa != MAP_FAILED)
+            {
+                m_data = static_cast<char *>(mapa);
+                m_velikost = velikost;
+                madvise(mapa, m_velikost, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+#else
+        (void)jmeno_souboru;
+        (void)velikost;
+        (void)zdroj;
+#endif
+    }
+
+    ~MapovanyVystup()
+    {
+#ifdef SIFRY_MMAP
+        if (m_data != nullptr)
+        {
+            munmap(m_data, m_velikost);
+        }
+#endif
+    }
+
+    MapovanyVystup(const MapovanyVystup &) = delete;
+    MapovanyVystup &operator=(const MapovanyVystup &) = delete;
+
+    bool namapovano() const { return m_data != nullptr; }
+    bool stejny_jako_vstup() const { return m_stejny_jako_vstup; }
+    char *data() { return m_data; }
+    size_t velikost() const { return m_velikost; }
+
+private:
+    char *m_data = nullptr;
+    size_t m_velikost = 0;
+    bool m_stejny_jako_vstup = false;
+};
+
+/**
+ * Funkce pro otevření souboru a načtení jeho obsahu do jednoho řetězce.
+ * Běžné soubory se čtou přes mmap jedním kopírováním, ostatní přes std::ifstream.
+ * @param jmeno_souboru Cesta k souboru
+ * @return Načtený obsah souboru jako std::string (nebo prázdný řetězec při chybě)
+ */
+std::string otevri_soubor(const std::string &jmeno_souboru)
+{
+    MapovanySoubor mapa(jmeno_souboru);
+    if (mapa.namapovano())
+    {
+        return std::string(mapa.data(), mapa.velikost());
+    }
+
+    std::ifstream ifs(jmeno_souboru, std::ios::in | std::ios::binary);
+    if (!ifs.is_open())
+    {
+        std::cerr << "Chyba: nepodařilo se otevřít soubor '" << jmeno_souboru << "'." << std::endl;
+        return {};
+    }
+    // Načteme obsah souboru do řetězce
+    std::string obsah((std::istreambuf_iterator<char>(ifs)),
+                      (std::istreambuf_iterator<char>()));
+    return obsah;
+}
+
+/**
+ * Pomocná funkce k Vigenere – vrací posun podle jednoho znaku klíče.
+ * Vycházíme z písmena v klíči (a=0, b=1, ..., z=25).
+ */
+static constexpr int vigenere_posun(char klic_char)
+{
+    // Budeme pracovat v malých písmenech (totéž co std::tolower v locale "C", jde ale i při překladu)
+    if (klic_char >= 'A' && klic_char <= 'Z')
+    {
+        klic_char = static_cast<char>(klic_char - 'A' + 'a');
+    }
+    return (klic_char - 'a') % 26; // posun 0..25
+}
+
+/**
+ * Posuny klíče Vigenerovy šifry převedené na 0..25 (už se směrem šifrování)
+ * a cyklicky prodloužené o ROZSIRENI_KLICE položek, aby vektorová jádra mohla
+ * načíst celý blok posunů od libovolné pozice v klíči.
+ */
+static const size_t ROZSIRENI_KLICE = 32;
+
+/**
+ * Pohled na připravené posuny; paměť vlastní kontext (nebo jde o tabulku
+ * vytvořenou při překladu, viz VigenerPevny).
+ */
+struct VigenerKlic
+{
+    const unsigned char *posuny;
+    size_t delka;
+};
+
+static constexpr unsigned char posun_klice(char klic_char, bool sifrovat)
+{
+    // vigenere_posun vrací -25..25 (i pro znaky mimo abecedu), modulo 26
+    // dává stejné písmeno jako výpočet v původní smyčce
+    int posun = vigenere_posun(klic_char);
+    if (!sifrovat)
+    {
+        posun = -posun;
+    }
+    return static_cast<unsigned char>((posun % 26 + 26) % 26);
+}
+
+/**
+ * Zapíše posuny klíče (klic.size() + ROZSIRENI_KLICE bajtů) do pole posuny.
+ */
+static void priprav_posuny(const std::string &klic, bool sifrovat, unsigned char *posuny)
+{
+    for (size_t i = 0; i < klic.size() + ROZSIRENI_KLICE; i++)
+    {
+        posuny[i] = posun_klice(klic[i % klic.size()], sifrovat);
+    }
+}
+
+static std::vector<unsigned char> priprav_posuny(const std::string &klic, bool sifrovat)
+{
+    std::vector<unsigned char> posuny(klic.size() + ROZSIRENI_KLICE);
+    priprav_posuny(klic, sifrovat, posuny.data());
+    return posuny;
+}
+
+/**
+ * Skalární jádra. posun je vždy 0..25, takže stačí jedno odečtení místo % 26.
+ * Znaky mimo [A-Za-z] projdou beze změny.
+ */
+static inline char posun_pismeno(char c, unsigned int posun)
+{
+    unsigned int t = static_cast<unsigned char>(c | 0x20) - 'a'; // malé i velké písmeno -> 0..25
+    if (t < 26)
+    {
+        unsigned int posunuto = t + posun;
+        if (posunuto >= 26)
+        {
+            posunuto -= 26;
+        }
+        c = static_cast<char>(c + static_cast<int>(posunuto) - static_cast<int>(t));
+    }
+    return c;
+}
+
+static void caesar_skalar(const char *vstup, char *vystup, size_t n, unsigned char posun)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        vystup[i] = posun_pismeno(vstup[i], posun);
+    }
+}
+
+// Vrací novou pozici v klíči (j se posouvá jen na písmenech)
+static size_t vigener_skalar(const char *vstup, char *vystup, size_t n, const VigenerKlic &klic, size_t j)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        char c = vstup[i];
+        unsigned int t = static_cast<unsigned char>(c | 0x20) - 'a';
+        if (t < 26)
+        {
+            c = posun_pismeno(c, klic.posuny[j]);
+            if (++j == klic.delka)
+            {
+                j = 0;
+            }
+        }
+        vystup[i] = c;
+    }
+    return j;
+}
+
+#ifdef SIFRY_X86_SIMD
+/**
+ * Vektorová jádra: písmena se rozpoznají porovnáním rozsahu bajtů (c | 0x20) - 'a'
+ * v 0..25, posun se přičte s přetočením přes 26 bez větvení a jiné znaky se
+ * propustí maskou beze změny. Velikost písmen se zachová, protože se k původnímu
+ * znaku přičítá jen rozdíl posunutého a původního pořadí v abecedě.
+ */
+__attribute__((target("sse2"))) static inline __m128i pismena_sse2(__m128i c)
+{
+    __m128i t = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    return _mm_and_si128(_mm_cmpgt_epi8(t, _mm_set1_epi8(-1)), _mm_cmplt_epi8(t, _mm_set1_epi8(26)));
+}
+
+__attribute__((target("sse2"))) static inline __m128i posun_sse2(__m128i c, __m128i pismena, __m128i posun)
+{
+    __m128i t = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i posunuto = _mm_add_epi8(t, posun);
+    posunuto = _mm_sub_epi8(posunuto, _mm_and_si128(_mm_cmpgt_epi8(posunuto, _mm_set1_epi8(25)), _mm_set1_epi8(26)));
+    return _mm_add_epi8(c, _mm_and_si128(_mm_sub_epi8(posunuto, t), pismena));
+}
+
+__attribute__((target("sse2"))) static void caesar_sse2(const char *vstup, char *vystup, size_t n, unsigned char posun)
+{
+    const __m128i p = _mm_set1_epi8(static_cast<char>(posun));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vstup + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(vystup + i), posun_sse2(c, pismena_sse2(c), p));
+    }
+    caesar_skalar(vstup + i, vystup + i, n - i, posun);
+}
+
+__attribute__((target("sse2"))) static size_t vigener_sse2(const char *vstup, char *vystup, size_t n, const VigenerKlic &klic, size_t j)
+{
+    alignas(16) unsigned char posuny[16] = {};
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vstup + i));
+        __m128i pismena = pismena_sse2(c);
+        unsigned int maska = static_cast<unsigned int>(_mm_movemask_epi8(pismena));
+        __m128i p;
+        if (maska == 0xFFFF)
+        {
+            // Samá písmena: posuny jdou v klíči za sebou
+            p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(klic.posuny + j));
+            j = (j + 16) % klic.delka;
+        }
+        else
+        {
+            // Každé písmeno dostane další posun klíče, ostatní pozice se maskují
+            for (; maska != 0; maska &= maska - 1)
+            {
+                posuny[__builtin_ctz(maska)] = klic.posuny[j];
+                if (++j == klic.delka)
+                {
+                    j = 0;
+                }
+            }
+            p = _mm_load_si128(reinterpret_cast<const __m128i *>(posuny));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(vystup + i), posun_sse2(c, pismena, p));
+    }
+    return vigener_skalar(vstup + i, vystup + i, n - i, klic, j);
+}
+
+__attribute__((target("avx2"))) static inline __m256i pismena_avx2(__m256i c)
+{
+    __m256i t = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    return _mm256_and_si256(_mm256_cmpgt_epi8(t, _mm256_set1_epi8(-1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(26), t));
+}
+
+__attribute__((target("avx2"))) static inline __m256i posun_avx2(__m256i c, __m256i pismena, __m256i posun)
+{
+    __m256i t = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i posunuto = _mm256_add_epi8(t, posun);
+    posunuto = _mm256_sub_epi8(posunuto, _mm256_and_si256(_mm256_cmpgt_epi8(posunuto, _mm256_set1_epi8(25)), _mm256_set1_epi8(26)));
+    return _mm256_add_epi8(c, _mm256_and_si256(_mm256_sub_epi8(posunuto, t), pismena));
+}
+
+__attribute__((target("avx2"))) static void caesar_avx2(const char *vstup, char *vystup, size_t n, unsigned char posun)
+{
+    const __m256i p = _mm256_set1_epi8(static_cast<char>(posun));
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vstup + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(vystup + i), posun_avx2(c, pismena_avx2(c), p));
+    }
+    caesar_sse2(vstup + i, vystup + i, n - i, posun);
+}
+
+__attribute__((target("avx2"))) static size_t vigener_avx2(const char *vstup, char *vystup, size_t n, const VigenerKlic &klic, size_t j)
+{
+    alignas(32) unsigned char posuny[32] = {};
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vstup + i));
+        __m256i pismena = pismena_avx2(c);
+        unsigned int maska = static_cast<unsigned int>(_mm256_movemask_epi8(pismena));
+        __m256i p;
+        if (maska == 0xFFFFFFFFu)
+        {
+            p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(klic.posuny + j));
+            j = (j + 32) % klic.delka;
+        }
+        else
+        {
+            for (; maska != 0; maska &= maska - 1)
+            {
+                posuny[__builtin_ctz(maska)] = klic.posuny[j];
+                if (++j == klic.delka)
+                {
+                    j = 0;
+                }
+            }
+            p = _mm256_load_si256(reinterpret_cast<const __m256i *>(posuny));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(vystup + i), posun_avx2(c, pismena, p));
+    }
+    return vigener_sse2(vstup + i, vystup + i, n - i, klic, j);
+}
+#endif // SIFRY_X86_SIMD
+
+typedef void (*CaesarJadro)(const char *, char *, size_t, unsigned char);
+typedef size_t (*VigenerJadro)(const char *, char *, size_t, const VigenerKlic &, size_t);
+
+/**
+ * Výběr jádra podle procesoru (CPUID) proběhne jednou, při prvním použití.
+ */
+static CaesarJadro caesar_jadro()
+{
+    static const CaesarJadro jadro = []() -> CaesarJadro {
+#ifdef SIFRY_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return caesar_avx2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return caesar_sse2;
+        }
+#endif
+        return caesar_skalar;
+    }();
+    return jadro;
+}
+
+static VigenerJadro vigener_jadro()
+{
+    static const VigenerJadro jadro = []() -> VigenerJadro {
+#ifdef SIFRY_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return vigener_avx2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return vigener_sse2;
+        }
+#endif
+        return vigener_skalar;
+    }();
+    return jadro;
+}
+
+/**
+ * Heslo XOR šifry předem rozvinuté do vzoru: heslo zopakované na délku
+ * delka + ROZSIRENI_XOR. Od libovolné pozice v hesle tak lze načíst celé slovo
+ * nebo vektor klíče jedním (nezarovnaným) čtením, bez modula pro každý bajt.
+ */
+static const size_t ROZSIRENI_XOR = 64;
+
+struct XorVzor
+{
+    const unsigned char *bajty;
+    size_t delka;
+};
+
+/**
+ * Zapíše vzor hesla (klic.size() + ROZSIRENI_XOR bajtů) do pole bajty.
+ */
+static void rozvin_heslo(const std::string &klic, unsigned char *bajty)
+{
+    for (size_t i = 0; i < klic.size() + ROZSIRENI_XOR; i++)
+    {
+        bajty[i] = static_cast<unsigned char>(klic[i % klic.size()]);
+    }
+}
+
+static std::vector<unsigned char> rozvin_heslo(const std::string &klic)
+{
+    std::vector<unsigned char> bajty(klic.size() + ROZSIRENI_XOR);
+    rozvin_heslo(klic, bajty.data());
+    return bajty;
+}
+
+/**
+ * XOR jádra zpracují blok šířky W bajtů a posunou pozici v hesle o W mod delka
+ * (jedno porovnání místo dělení). Vrací pozici v hesle po posledním bajtu.
+ * Skalární jádro pracuje po 64bitových slovech.
+ */
+static size_t xor_skalar(const char *vstup, char *vystup, size_t n, const XorVzor &vzor, size_t pozice)
+{
+    const size_t krok = 8 % vzor.delka;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t slovo, klic;
+        std::memcpy(&slovo, vstup + i, 8);
+        std::memcpy(&klic, vzor.bajty + pozice, 8);
+        slovo ^= klic;
+        std::memcpy(vystup + i, &slovo, 8);
+        pozice += krok;
+        if (pozice >= vzor.delka)
+        {
+            pozice -= vzor.delka;
+        }
+    }
+    for (; i < n; i++)
+    {
+        vystup[i] = static_cast<char>(vstup[i] ^ vzor.bajty[pozice]);
+        if (++pozice == vzor.delka)
+        {
+            pozice = 0;
+        }
+    }
+    return pozice;
+}
+
+#ifdef SIFRY_X86_SIMD
+__attribute__((target("sse2"))) static size_t xor_sse2(const char *vstup, char *vystup, size_t n, const XorVzor &vzor, size_t pozice)
+{
+    const size_t krok = 16 % vzor.delka;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vstup + i));
+        __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vzor.bajty + pozice));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(vystup + i), _mm_xor_si128(v, k));
+        pozice += krok;
+        if (pozice >= vzor.delka)
+        {
+            pozice -= vzor.delka;
+        }
+    }
+    return xor_skalar(vstup + i, vystup + i, n - i, vzor, pozice);
+}
+
+__attribute__((target("avx2"))) static size_t xor_avx2(const char *vstup, char *vystup, size_t n, const XorVzor &vzor, size_t pozice)
+{
+    const size_t krok = 32 % vzor.delka;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vstup + i));
+        __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vzor.bajty + pozice));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(vystup + i), _mm256_xor_si256(v, k));
+        pozice += krok;
+        if (pozice >= vzor.delka)
+        {
+            pozice -= vzor.delka;
+        }
+    }
+    return xor_sse2(vstup + i, vystup + i, n - i, vzor, pozice);
+}
+
+__attribute__((target("avx512f"))) static size_t xor_avx512(const char *vstup, char *vystup, size_t n, const XorVzor &vzor, size_t pozice)
+{
+    const size_t krok = 64 % vzor.delka;
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        __m512i v = _mm512_loadu_si512(vstup + i);
+        __m512i k = _mm512_loadu_si512(vzor.bajty + pozice);
+        _mm512_storeu_si512(vystup + i, _mm512_xor_si512(v, k));
+        pozice += krok;
+        if (pozice >= vzor.delka)
+        {
+            pozice -= vzor.delka;
+        }
+    }
+    return xor_avx2(vstup + i, vystup + i, n - i, vzor, pozice);
+}
+#endif // SIFRY_X86_SIMD
+
+typedef size_t (*XorJadro)(const char *, char *, size_t, const XorVzor &, size_t);
+
+static XorJadro xor_jadro()
+{
+    static const XorJadro jadro = []() -> XorJadro {
+#ifdef SIFRY_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return xor_avx512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return xor_avx2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return xor_sse2;
+        }
+#endif
+        return xor_skalar;
+    }();
+    return jadro;
+}
+
+/**
+ * Převodní tabulka Caesarovy šifry pro všech 256 bajtů podle původního vzorce
+ * (posun už se znaménkem podle směru). Je constexpr, jde ji tedy spočítat už při překladu.
+ */
+static constexpr std::array<char, 256> caesar_tabulka(int posun)
+{
+    std::array<char, 256> tabulka = {};
+    for (int b = 0; b < 256; b++)
+    {
+        char c = static_cast<char>(b);
+        bool velke = b >= 'A' && b <= 'Z';
+        if (velke || (b >= 'a' && b <= 'z'))
+        {
+            char zaklad = velke ? 'A' : 'a';
+            c = static_cast<char>(zaklad + ((static_cast<long long>(c - zaklad) + posun + 26) % 26));
+        }
+        tabulka[b] = c;
+    }
+    return tabulka;
+}
+
+/**
+ * Klíč jako parametr šablony, např. VigenerPevny<"tajnyklic">.
+ */
+template <size_t N>
+struct PevnyKlic
+{
+    char znaky[N];
+
+    constexpr PevnyKlic(const char (&retezec)[N])
+    {
+        std::copy_n(retezec, N, znaky);
+    }
+
+    constexpr size_t delka() const
+    {
+        return N - 1;
+    }
+};
+
+/**
+ * Šifry s posunem nebo klíčem známým při překladu: tabulky, které by se jinak
+ * počítaly při každém vytvoření kontextu, jsou constexpr data v programu.
+ */
+template <int POSUN, bool SIFROVAT = true>
+struct CaesarPevny
+{
+    static constexpr int posun = SIFROVAT ? POSUN : -POSUN;
+    static constexpr std::array<char, 256> tabulka = caesar_tabulka(posun);
+};
+
+template <PevnyKlic KLIC, bool SIFROVAT = true>
+struct VigenerPevny
+{
+    static_assert(KLIC.delka() > 0, "Klíč nesmí být prázdný.");
+
+    static constexpr std::array<unsigned char, KLIC.delka() + ROZSIRENI_KLICE> posuny = [] {
+        std::array<unsigned char, KLIC.delka() + ROZSIRENI_KLICE> p = {};
+        for (size_t i = 0; i < p.size(); i++)
+        {
+            p[i] = posun_klice(KLIC.znaky[i % KLIC.delka()], SIFROVAT);
+        }
+        return p;
+    }();
+};
+
+template <PevnyKlic KLIC>
+struct XorPevny
+{
+    static_assert(KLIC.delka() > 0, "Heslo nesmí být prázdné.");
+
+    static constexpr std::array<unsigned char, KLIC.delka() + ROZSIRENI_XOR> bajty = [] {
+        std::array<unsigned char, KLIC.delka() + ROZSIRENI_XOR> b = {};
+        for (size_t i = 0; i < b.size(); i++)
+        {
+            b[i] = static_cast<unsigned char>(KLIC.znaky[i % KLIC.delka()]);
+        }
+        return b;
+    }();
+};
+
+/**
+ * Registr klíčů známých při překladu. Kontext se při vytvoření podívá, zda je
+ * jeho klíč registrovaný, a pokud ano, použije hotové tabulky místo jejich
+ * výpočtu (a alokace) za běhu. Registruje se typicky na začátku programu, např.
+ * registruj_vigener<"tajnyklic">().
+ */
+struct RegistrPevnychKlicu
+{
+    std::map<int, const char *> caesar;          // posun se znaménkem -> tabulka
+    std::map<std::string, VigenerKlic> vigener[2]; // [šifrovat] klíč -> posuny
+    std::map<std::string, XorVzor> xor_vzory;
+};
+
+/**
+ * Hledání v registru je na cestě každého volání šifry, proto je bez zámku:
+ * načte atomický ukazatel na neměnný snímek registru. Registrace pod zámkem
+ * snímek zkopíruje, doplní a vyvěsí kopii. Staré snímky mohou ještě číst jiná
+ * vlákna, uvolní se až na konci programu; nový snímek vzniká jen pro dosud
+ * neregistrovaný klíč, takže jich je nejvýš tolik, kolik je různých klíčů.
+ */
+struct SnimkyRegistru
+{
+    std::mutex zamek;
+    std::vector<std::unique_ptr<RegistrPevnychKlicu>> snimky;
+    std::atomic<const RegistrPevnychKlicu *> aktualni{nullptr};
+};
+
+static SnimkyRegistru &registr()
+{
+    static SnimkyRegistru r;
+    return r;
+}
+
+/**
+ * Zavolá zmena(kopie) nad kopií aktuálního registru; vrátí-li true (registr se
+ * změnil), kopie se stane aktuálním registrem.
+ */
+template <typename Zmena>
+static void uprav_registr(Zmena zmena)
+{
+    SnimkyRegistru &r = registr();
+    std::lock_guard<std::mutex> zamek(r.zamek);
+    const RegistrPevnychKlicu *aktualni = r.aktualni.load(std::memory_order_relaxed);
+    auto kopie = aktualni != nullptr ? std::make_unique<RegistrPevnychKlicu>(*aktualni)
+                                     : std::make_unique<RegistrPevnychKlicu>();
+    if (!zmena(*kopie))
+    {
+        return;
+    }
+    r.aktualni.store(kopie.get(), std::memory_order_release);
+    r.snimky.push_back(std::move(kopie));
+}
+
+/** Zaregistruje posun pro šifrování i dešifrování. */
+template <int POSUN>
+void registruj_caesar()
+{
+    uprav_registr([](RegistrPevnychKlicu &r) {
+        bool nove = r.caesar.emplace(CaesarPevny<POSUN, true>::posun, CaesarPevny<POSUN, true>::tabulka.data()).second;
+        return r.caesar.emplace(CaesarPevny<POSUN, false>::posun, CaesarPevny<POSUN, false>::tabulka.data()).second || nove;
+    });
+}
+
+/** Zaregistruje klíč pro šifrování i dešifrování. */
+template <PevnyKlic KLIC>
+void registruj_vigener()
+{
+    uprav_registr([](RegistrPevnychKlicu &r) {
+        std::string klic(KLIC.znaky, KLIC.delka());
+        bool nove = r.vigener[true].emplace(klic, VigenerKlic{VigenerPevny<KLIC, true>::posuny.data(), KLIC.delka()}).second;
+        return r.vigener[false].emplace(klic, VigenerKlic{VigenerPevny<KLIC, false>::posuny.data(), KLIC.delka()}).second || nove;
+    });
+}
+
+template <PevnyKlic KLIC>
+void registruj_xor()
+{
+    uprav_registr([](RegistrPevnychKlicu &r) {
+        return r.xor_vzory.emplace(std::string(KLIC.znaky, KLIC.delka()), XorVzor{XorPevny<KLIC>::bajty.data(), KLIC.delka()}).second;
+    });
+}
+
+static const char *najdi_caesar(int posun)
+{
+    const RegistrPevnychKlicu *r = registr().aktualni.load(std::memory_order_acquire);
+    if (r == nullptr)
+    {
+        return nullptr;
+    }
+    auto it = r->caesar.find(posun);
+    return it == r->caesar.end() ? nullptr : it->second;
+}
+
+static std::optional<VigenerKlic> najdi_vigener(const std::string &klic, bool sifrovat)
+{
+    const RegistrPevnychKlicu *r = registr().aktualni.load(std::memory_order_acquire);
+    if (r == nullptr)
+    {
+        return std::nullopt;
+    }
+    auto it = r->vigener[sifrovat].find(klic);
+    if (it == r->vigener[sifrovat].end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+static std::optional<XorVzor> najdi_xor(const std::string &klic)
+{
+    const RegistrPevnychKlicu *r = registr().aktualni.load(std::memory_order_acquire);
+    if (r == nullptr)
+    {
+        return std::nullopt;
+    }
+    auto it = r->xor_vzory.find(klic);
+    if (it == r->xor_vzory.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+/**
+ * Počet vláken pro n bajtů: 0 znamená podle počtu jader. Každé vlákno dostane
+ * aspoň 64 KiB, menší vstupy se zpracují v jednom vlákně.
+ */
+static unsigned int pocet_vlaken(size_t n, unsigned int vlakna)
+{
+    if (vlakna == 0)
+    {
+        vlakna = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t nejvic = std::max<size_t>(1, n / (64 * 1024));
+    return static_cast<unsigned int>(std::min<size_t>(vlakna, nejvic));
+}
+
+/**
+ * Spustí ukol(i) pro i = 0..vlakna-1 ve vlastních vláknech (úloha 0 ve volajícím)
+ * a počká na všechna.
+ */
+static void paralelne(unsigned int vlakna, const std::function<void(unsigned int)> &ukol)
+{
+    std::vector<std::thread> pracovnici;
+    for (unsigned int i = 1; i < vlakna; i++)
+    {
+        pracovnici.emplace_back(ukol, i);
+    }
+    ukol(0);
+    for (std::thread &t : pracovnici)
+    {
+        t.join();
+    }
+}
+
+// Začátek i-tého z k souvislých úseků délky n
+static size_t hranice_useku(size_t n, unsigned int k, unsigned int i)
+{
+    return n / k * i + std::min<size_t>(i, n % k);
+}
+
+// Počet písmen [A-Za-z] v úseku (smyčku bez větvení kompilátor vektorizuje)
+static size_t pocet_pismen(const char *data, size_t n)
+{
+    size_t pocet = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        pocet += static_cast<unsigned char>((data[i] | 0x20) - 'a') < 26;
+    }
+    return pocet;
+}
+
+/**
+ * Šifrovací kontext: šifra i se svým stavem mezi voláními (pozice v klíči
+ * u Vigenera a XOR). Díky tomu lze data zpracovat po libovolných blocích
+ * a výsledek je stejný, jako kdyby se zpracovala najednou.
+ */
+class SifrovaciKontext
+{
+public:
+    SifrovaciKontext() = default;
+    // Kontexty mohou ukazovat do vlastní paměti (tabulky, posuny klíče), kopírování proto zakážeme
+    SifrovaciKontext(const SifrovaciKontext &) = delete;
+    SifrovaciKontext &operator=(const SifrovaciKontext &) = delete;
+    virtual ~SifrovaciKontext() = default;
+
+    /**
+     * Zpracuje n bajtů ze vstupu do výstupu a posune stav šifry.
+     * vstup a vystup mohou ukazovat na stejnou paměť (zpracování na místě).
+     */
+    virtual void zpracuj(const char *vstup, char *vystup, size_t n) = 0;
+
+    /**
+     * Totéž co zpracuj, ale rozdělené mezi vlákna (0 = podle počtu jader).
+     * Výsledek i nový stav jsou bajt po bajtu stejné jako u zpracuj.
+     */
+    virtual void zpracuj_paralelne(const char *vstup, char *vystup, size_t n, unsigned int vlakna) = 0;
+
+    /**
+     * Vytvoří opačnou šifru (pro šifrování dešifrovací a naopak) ve výchozím
+     * stavu, tj. od začátku klíče. Ze stavu tohoto kontextu nic nepřebírá.
+     */
+    virtual std::unique_ptr<SifrovaciKontext> inverzni() const = 0;
+};
+
+/**
+ * Caesarova šifra jako kontext (nemá stav, posun je pro všechny znaky stejný).
+ */
+class CaesarKontext : public SifrovaciKontext
+{
+public:
+    /**
+     * @param posun Posun (např. 3)
+     * @param sifrovat true -> šifrování, false -> dešifrování (záporný posun)
+     */
+    CaesarKontext(int posun, bool sifrovat) : m_zadany_posun(posun), m_sifrovat(sifrovat)
+    {
+        // Pokud dešifrujeme, otočíme znaménko posunu
+        if (!sifrovat)
+        {
+            posun = -posun;
+        }
+        const char *pevna = najdi_caesar(posun);
+        if (posun >= -26 && posun <= INT_MAX - 51)
+        {
+            // Pro tyto posuny dává ( (c - 'A') + posun + 26 ) % 26 vždy 0..25,
+            // tedy totéž co posun o (posun mod 26) - to umí vektorová jádra.
+            // Registrovaná tabulka se vyplatí jen tam, kde vektorová jádra nejsou.
+            m_posun = static_cast<unsigned char>((posun % 26 + 26) % 26);
+            if (pevna != nullptr && caesar_jadro() == caesar_skalar)
+            {
+                m_tabulka = pevna;
+            }
+            return;
+        }
+
+        // Velké záporné posuny: zachováme přesně chování původního vzorce
+        // (záporný zbytek po dělení) pomocí převodní tabulky pro všech 256 bajtů
+        if (pevna == nullptr)
+        {
+            m_vlastni_tabulka = caesar_tabulka(posun);
+            pevna = m_vlastni_tabulka.data();
+        }
+        m_tabulka = pevna;
+    }
+
+    void zpracuj_paralelne(const char *vstup, char *vystup, size_t n, unsigned int vlakna) override
+    {
+        // Bez stavu - úseky jsou zcela nezávislé
+        vlakna = pocet_vlaken(n, vlakna);
+        paralelne(vlakna, [&](unsigned int i) {
+            size_t od = hranice_useku(n, vlakna, i);
+            zpracuj(vstup + od, vystup + od, hranice_useku(n, vlakna, i + 1) - od);
+        });
+    }
+
+    void zpracuj(const char *vstup, char *vystup, size_t n) override
+    {
+        if (m_tabulka == nullptr)
+        {
+            caesar_jadro()(vstup, vystup, n, m_posun);
+            return;
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            vystup[i] = m_tabulka[static_cast<unsigned char>(vstup[i])];
+        }
+    }
+
+    std::unique_ptr<SifrovaciKontext> inverzni() const override
+    {
+        return std::make_unique<CaesarKontext>(m_zadany_posun, !m_sifrovat);
+    }
+
+private:
+    int m_zadany_posun;
+    bool m_sifrovat;
+    unsigned char m_posun = 0;
+    const char *m_tabulka = nullptr; // nullptr = vektorové jádro s posunem m_posun
+    std::array<char, 256> m_vlastni_tabulka;
+};
+
+/**
+ * Vigenerova šifra jako kontext; pamatuje si pozici v klíči (posouvá se jen na písmenech).
+ */
+class VigenerKontext : public SifrovaciKontext
+{
+public:
+    VigenerKontext(const std::string &klic, bool sifrovat) : m_heslo(klic), m_sifrovat(sifrovat)
+    {
+        if (klic.empty())
+        {
+            return;
+        }
+        if (std::optional<VigenerKlic> pevny = najdi_vigener(klic, sifrovat))
+        {
+            m_klic = *pevny;
+            return;
+        }
+        m_posuny = priprav_posuny(klic, sifrovat);
+        m_klic = {m_posuny.data(), klic.size()};
+    }
+
+    void zpracuj(const char *vstup, char *vystup, size_t n) override
+    {
+        if (m_klic.delka == 0)
+        {
+            // Bez klíče nic neděláme, text projde beze změn
+            std::copy(vstup, vstup + n, vystup);
+            return;
+        }
+        m_pozice = vigener_jadro()(vstup, vystup, n, m_klic, m_pozice);
+    }
+
+    /**
+     * Pozice v klíči závisí na počtu písmen před každým znakem. Vlákna proto
+     * nejdřív spočítají písmena ve svých úsecích, prefixový součet těchto počtů
+     * dá každému úseku jeho počáteční pozici v klíči a pak se úseky šifrují nezávisle.
+     */
+    void zpracuj_paralelne(const char *vstup, char *vystup, size_t n, unsigned int vlakna) override
+    {
+        vlakna = pocet_vlaken(n, vlakna);
+        if (m_klic.delka == 0 || vlakna == 1)
+        {
+            zpracuj(vstup, vystup, n);
+            return;
+        }
+
+        std::vector<size_t> pismen(vlakna);
+        paralelne(vlakna, [&](unsigned int i) {
+            size_t od = hranice_useku(n, vlakna, i);
+            pismen[i] = pocet_pismen(vstup + od, hranice_useku(n, vlakna, i + 1) - od);
+        });
+
+        std::vector<size_t> pocatky(vlakna);
+        size_t pozice = m_pozice;
+        for (unsigned int i = 0; i < vlakna; i++)
+        {
+            pocatky[i] = pozice;
+            pozice = (pozice + pismen[i]) % m_klic.delka;
+        }
+
+        VigenerJadro jadro = vigener_jadro();
+        paralelne(vlakna, [&](unsigned int i) {
+            size_t od = hranice_useku(n, vlakna, i);
+            jadro(vstup + od, vystup + od, hranice_useku(n, vlakna, i + 1) - od, m_klic, pocatky[i]);
+        });
+        m_pozice = pozice;
+    }
+
+    std::unique_ptr<SifrovaciKontext> inverzni() const override
+    {
+        return std::make_unique<VigenerKontext>(m_heslo, !m_sifrovat);
+    }
+
+private:
+    std::string m_heslo;
+    bool m_sifrovat;
+    std::vector<unsigned char> m_posuny;
+    VigenerKlic m_klic = {nullptr, 0};
+    size_t m_pozice = 0;
+};
+
+/**
+ * XOR šifra jako kontext; pamatuje si pozici v hesle.
+ */
+class XorKontext : public SifrovaciKontext
+{
+public:
+    /**
+     * @param klic Heslo
+     * @param pocatecni_pozice Pozice v hesle, od které se začíná (pro navázání
+     *        na data zpracovaná jinde, např. v jiném bloku souboru)
+     */
+    explicit XorKontext(const std::string &klic, size_t pocatecni_pozice = 0) : m_heslo(klic)
+    {
+        if (klic.empty())
+        {
+            return;
+        }
+        m_pocatek = pocatecni_pozice % klic.size();
+        m_pozice = m_pocatek;
+        if (std::optional<XorVzor> pevny = najdi_xor(klic))
+        {
+            m_vzor = *pevny;
+            return;
+        }
+        m_bajty = rozvin_heslo(klic);
+        m_vzor = {m_bajty.data(), klic.size()};
+    }
+
+    void zpracuj(const char *vstup, char *vystup, size_t n) override
+    {
+        if (m_vzor.delka == 0)
+        {
+            // Bez klíče nic neděláme
+            std::copy(vstup, vstup + n, vystup);
+            return;
+        }
+        m_pozice = xor_jadro()(vstup, vystup, n, m_vzor, m_pozice);
+    }
+
+    void zpracuj_paralelne(const char *vstup, char *vystup, size_t n, unsigned int vlakna) override
+    {
+        vlakna = pocet_vlaken(n, vlakna);
+        if (m_vzor.delka == 0 || vlakna == 1)
+        {
+            zpracuj(vstup, vystup, n);
+            return;
+        }
+        // Pozice v hesle na začátku úseku je dána jen jeho polohou v datech
+        XorJadro jadro = xor_jadro();
+        paralelne(vlakna, [&](unsigned int i) {
+            size_t od = hranice_useku(n, vlakna, i);
+            jadro(vstup + od, vystup + od, hranice_useku(n, vlakna, i + 1) - od, m_vzor, (m_pozice + od) % m_vzor.delka);
+        });
+        m_pozice = (m_pozice + n) % m_vzor.delka;
+    }
+
+    std::unique_ptr<SifrovaciKontext> inverzni() const override
+    {
+        // XOR je sám sobě inverzí, musí ale začínat na stejné pozici v hesle
+        return std::make_unique<XorKontext>(m_heslo, m_pocatek);
+    }
+
+private:
+    std::string m_heslo;
+    std::vector<unsigned char> m_bajty;
+    XorVzor m_vzor = {nullptr, 0};
+    size_t m_pocatek = 0;
+    size_t m_pozice = 0;
+};
+
+/**
+ * Řetězec šifer, např. Vigener a potom XOR. Data prochází všemi šiframi najednou
+ * po blocích, které se vejdou do cache: první šifra čte ze vstupu do výstupu,
+ * další už pracují na místě nad stejným blokem. Oproti postupnému volání šifer
+ * nad celým textem tak nevznikají mezivýsledky a data se z paměti čtou jen jednou.
+ * Sám je kontextem, lze ho tedy předat do sifruj_soubor nebo vnořit do jiného řetězce.
+ */
+class SifrovaciRetezec : public SifrovaciKontext
+{
+public:
+    /** Velikost bloku, který projde všemi šiframi, než se pokračuje dalším. */
+    static constexpr size_t VELIKOST_BLOKU = 16 * 1024;
+
+    /**
+     * Přidá šifru na konec řetězce.
+     * @return *this, aby šlo psát retezec.pridej(...).pridej(...)
+     */
+    SifrovaciRetezec &pridej(std::unique_ptr<SifrovaciKontext> sifra)
+    {
+        if (!sifra)
+        {
+            throw std::invalid_argument("Šifra v řetězci nesmí být prázdná.");
+        }
+        m_sifry.push_back(std::move(sifra));
+        return *this;
+    }
+
+    size_t pocet_sifer() const
+    {
+        return m_sifry.size();
+    }
+
+    void zpracuj(const char *vstup, char *vystup, size_t n) override
+    {
+        if (m_sifry.empty())
+        {
+            std::copy(vstup, vstup + n, vystup);
+            return;
+        }
+        for (size_t od = 0; od < n; od += VELIKOST_BLOKU)
+        {
+            size_t delka = std::min(VELIKOST_BLOKU, n - od);
+            m_sifry[0]->zpracuj(vstup + od, vystup + od, delka);
+            for (size_t s = 1; s < m_sifry.size(); s++)
+            {
+                m_sifry[s]->zpracuj(vystup + od, vystup + od, delka);
+            }
+        }
+    }
+
+    /**
+     * Vlákna si dělí větší bloky (VELIKOST_BLOKU na vlákno, aby se vlákna
+     * nespouštěla zbytečně často), každý blok opět projde všemi šiframi.
+     */
+    void zpracuj_paralelne(const char *vstup, char *vystup, size_t n, unsigned int vlakna) override
+    {
+        if (m_sifry.empty())
+        {
+            std::copy(vstup, vstup + n, vystup);
+            return;
+        }
+        vlakna = pocet_vlaken(n, vlakna);
+        if (vlakna == 1)
+        {
+            zpracuj(vstup, vystup, n);
+            return;
+        }
+        const size_t blok = 16 * VELIKOST_BLOKU * vlakna;
+        for (size_t od = 0; od < n; od += blok)
+        {
+            size_t delka = std::min(blok, n - od);
+            m_sifry[0]->zpracuj_paralelne(vstup + od, vystup + od, delka, vlakna);
+            for (size_t s = 1; s < m_sifry.size(); s++)
+            {
+                m_sifry[s]->zpracuj_paralelne(vystup + od, vystup + od, delka, vlakna);
+            }
+        }
+    }
+
+    /**
+     * Inverzní řetězec: opačné šifry v obráceném pořadí.
+     */
+    std::unique_ptr<SifrovaciKontext> inverzni() const override
+    {
+        auto retezec = std::make_unique<SifrovaciRetezec>();
+        for (auto it = m_sifry.rbegin(); it != m_sifry.rend(); ++it)
+        {
+            retezec->pridej((*it)->inverzni());
+        }
+        return retezec;
+    }
+
+private:
+    std::vector<std::unique_ptr<SifrovaciKontext>> m_sifry;
+};
+
+/**
+ * Ověří, že výstupní buffer stačí na výsledek; jinak hází std::invalid_argument.
+ */
+static void over_velikost(std::span<const char> vstup, std::span<char> vystup)
+{
+    if (vystup.size() < vstup.size())
+    {
+        throw std::invalid_argument("Výstupní buffer je menší než vstup.");
+    }
+}
+
+/**
+ * Klíče do této délky si span varianty šifer připraví v poli na zásobníku,
+ * delší klíče potřebují pole na haldě.
+ */
+static const size_t KRATKY_KLIC = 256;
+
+/**
+ * Caesarova šifra pro šifrování/dešifrování bez alokace.
+ * Varianta s jedním bufferem šifruje na místě, varianta se dvěma zapisuje
+ * výsledek do bufferu volajícího (musí být aspoň tak velký jako vstup).
+ *
+ * Pozn.: Upravuje pouze písmena [A-Za-z]. Zachovává velikost písmen.
+ */
+void caesar_sifra(std::span<const char> vstup, std::span<char> vystup, int posun, bool sifrovat)
+{
+    over_velikost(vstup, vystup);
+    CaesarKontext(posun, sifrovat).zpracuj(vstup.data(), vystup.data(), vstup.size());
+}
+
+void caesar_sifra(std::span<char> text, int posun, bool sifrovat)
+{
+    caesar_sifra(text, text, posun, sifrovat);
+}
+
+/**
+ * Caesarova šifra pro šifrování/dešifrování.
+ *
+ * @param text Vstupní text (otevřený nebo zašifrovaný)
+ * @param posun Posun (např. 3) – pro dešifrování se použije záporný posun
+ *              v případě sifrovat=false.
+ * @param sifrovat true -> šifrování, false -> dešifrování
+ * @return Výsledný (zašifrovaný či dešifrovaný) text
+ *
+ * Pozn.: Upravuje pouze písmena [A-Za-z]. Zachovává velikost písmen.
+ */
+std::string caesar_sifra(const std::string &text, int posun, bool sifrovat)
+{
+    std::string vystup(text.size(), '\0');
+    caesar_sifra(text, vystup, posun, sifrovat);
+    return vystup;
+}
+
+/**
+ * Vigenerova šifra na místě nebo do bufferu volajícího. Pro klíče do KRATKY_KLIC
+ * znaků (a klíče z registru) nealokuje: posuny klíče se připraví na zásobníku.
+ *
+ * Pozn.: Upravuje pouze písmena [A-Za-z]. Zachovává velikost písmen.
+ */
+void vigener_sifra(std::span<const char> vstup, std::span<char> vystup, const std::string &klic, bool sifrovat)
+{
+    over_velikost(vstup, vystup);
+    if (klic.empty())
+    {
+        // Bez klíče nic neděláme, text projde beze změn
+        std::copy(vstup.begin(), vstup.end(), vystup.begin());
+        return;
+    }
+    if (std::optional<VigenerKlic> pevny = najdi_vigener(klic, sifrovat))
+    {
+        vigener_jadro()(vstup.data(), vystup.data(), vstup.size(), *pevny, 0);
+        return;
+    }
+
+    unsigned char na_zasobniku[KRATKY_KLIC + ROZSIRENI_KLICE];
+    std::vector<unsigned char> na_halde;
+    unsigned char *posuny = na_zasobniku;
+    if (klic.size() > KRATKY_KLIC)
+    {
+        na_halde.resize(klic.size() + ROZSIRENI_KLICE);
+        posuny = na_halde.data();
+    }
+    priprav_posuny(klic, sifrovat, posuny);
+    vigener_jadro()(vstup.data(), vystup.data(), vstup.size(), VigenerKlic{posuny, klic.size()}, 0);
+}
+
+void vigener_sifra(std::span<char> text, const std::string &klic, bool sifrovat)
+{
+    vigener_sifra(text, text, klic, sifrovat);
+}
+
+/**
+ * Vigenere šifra pro šifrování/dešifrování.
+ * @param text Vstupní text (otevřený nebo zašifrovaný)
+ * @param klic Klíčové slovo (např. "tajne")
+ * @param sifrovat true -> šifrování, false -> dešifrování
+ * @return Výsledný zašifrovaný nebo dešifrovaný text
+ *
+ * Pozn.: Upravuje pouze písmena [A-Za-z]. Zachovává velikost písmen.
+ */
+std::string vigener_sifra(const std::string &text, const std::string &klic, bool sifrovat)
+{
+    std::string vystup(text.size(), '\0');
+    vigener_sifra(text, vystup, klic, sifrovat);
+    return vystup;
+}
+
+/**
+ * XOR šifra na místě nebo do bufferu volajícího. Pro hesla do KRATKY_KLIC znaků
+ * (a hesla z registru) nealokuje: vzor hesla se rozvine na zásobníku.
+ */
+void xor_sifra(std::span<const char> vstup, std::span<char> vystup, const std::string &klic, bool /*sifrovat*/)
+{
+    over_velikost(vstup, vystup);
+    if (klic.empty())
+    {
+        // Bez klíče nic neděláme
+        std::copy(vstup.begin(), vstup.end(), vystup.begin());
+        return;
+    }
+    if (std::optional<XorVzor> pevny = najdi_xor(klic))
+    {
+        xor_jadro()(vstup.data(), vystup.data(), vstup.size(), *pevny, 0);
+        return;
+    }
+
+    unsigned char na_zasobniku[KRATKY_KLIC + ROZSIRENI_XOR];
+    std::vector<unsigned char> na_halde;
+    unsigned char *bajty = na_zasobniku;
+    if (klic.size() > KRATKY_KLIC)
+    {
+        na_halde.resize(klic.size() + ROZSIRENI_XOR);
+        bajty = na_halde.data();
+    }
+    rozvin_heslo(klic, bajty);
+    xor_jadro()(vstup.data(), vystup.data(), vstup.size(), XorVzor{bajty, klic.size()}, 0);
+}
+
+void xor_sifra(std::span<char> text, const std::string &klic, bool sifrovat)
+{
+    xor_sifra(text, text, klic, sifrovat);
+}
+
+/**
+ * XOR šifra: provádí XOR s heslem pro každý znak.
+ * Protože XOR je inverzní sama sobě, funkce je stejná pro šifrování i dešifrování.
+ *
+ * @param text Vstupní text
+ * @param klic Klíč (heslo) – zpracovává se po znacích (cyklicky)
+ * @param sifrovat true -> "šifruj", false -> "dešifruj" (ve skutečnosti je to totéž)
+ * @return Text po XOR operaci
+ */
+std::string xor_sifra(const std::string &text, const std::string &klic, bool sifrovat)
+{
+    std::string vystup(text.size(), '\0');
+    xor_sifra(text, vystup, klic, sifrovat);
+    return vystup;
+}
+
+/**
+ * Vícevláknové verze šifer pro velké texty; výstup je stejný jako u jednovláknových.
+ * @param vlakna Počet vláken, 0 = podle počtu jader
+ */
+std::string caesar_sifra_paralelne(const std::string &text, int posun, bool sifrovat, unsigned int vlakna = 0)
+{
+    std::string vystup(text.size(), '\0');
+    CaesarKontext(posun, sifrovat).zpracuj_paralelne(text.data(), &vystup[0], text.size(), vlakna);
+    return vystup;
+}
+
+std::string vigener_sifra_paralelne(const std::string &text, const std::string &klic, bool sifrovat, unsigned int vlakna = 0)
+{
+    std::string vystup(text.size(), '\0');
+    VigenerKontext(klic, sifrovat).zpracuj_paralelne(text.data(), &vystup[0], text.size(), vlakna);
+    return vystup;
+}
+
+std::string xor_sifra_paralelne(const std::string &text, const std::string &klic, unsigned int vlakna = 0)
+{
+    std::string vystup(text.size(), '\0');
+    XorKontext(klic).zpracuj_paralelne(text.data(), &vystup[0], text.size(), vlakna);
+    return vystup;
+}
+
+/**
+ * Uloží daný řetězec do zadaného souboru. Pokud se nepodaří otevřít, vypíše chybu.
+ * @param jmeno_souboru Název/cesta k souboru
+ * @param obsah Řetězec k uložení
+ */
+void uloz_do_souboru(const std::string &jmeno_souboru, const std::string &obsah)
+{
+    MapovanyVystup mapa(jmeno_souboru, obsah.size());
+    if (mapa.namapovano())
+    {
+        std::copy(obsah.begin(), obsah.end(), mapa.data());
+        return;
+    }
+
+    std::ofstream ofs(jmeno_souboru, std::ios::out | std::ios::binary);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Chyba: nepodařilo se otevřít soubor '" << jmeno_souboru << "' pro zápis." << std::endl;
+        return;
+    }
+    ofs.write(obsah.data(), static_cast<std::streamsize>(obsah.size()));
+}
+
+/**
+ * Zašifruje (nebo dešifruje) soubor. Jde-li vstup i výstup namapovat, šifra čte
+ * přímo ze stránek vstupu a zapisuje do stránek výstupu bez mezibufferu.
+ * Jinak (roury apod.) se soubor zpracuje po blocích pevné velikosti, takže paměť
+ * nezávisí na velikosti souboru. Stav šifry se přenáší mezi bloky v kontextu,
+ * výstup je proto stejný jako při zpracování celého souboru najednou.
+ *
+ * @param vstup Cesta ke vstupnímu souboru
+ * @param vystup Cesta k výstupnímu souboru
+ * @param kontext Šifra se svým stavem (např. VigenerKontext)
+ * @param velikost_bloku Velikost bloku v bajtech
+ * @param vlakna Počet vláken pro šifrování (1 = jednovláknově, 0 = podle počtu jader)
+ * @return true při úspěchu, false při chybě čtení nebo zápisu
+ */
+bool sifruj_soubor(const std::string &vstup, const std::string &vystup, SifrovaciKontext &kontext,
+                   size_t velikost_bloku = 1 << 20, unsigned int vlakna = 1)
+{
+    {
+        MapovanySoubor vstupni_mapa(vstup);
+        if (vstupni_mapa.namapovano())
+        {
+            MapovanyVystup vystupni_mapa(vystup, vstupni_mapa.velikost(), &vstupni_mapa);
+            if (vystupni_mapa.stejny_jako_vstup())
+            {
+                // Zápis přes proud by vstup zkrátil dřív, než by se přečetl
+                std::cerr << "Chyba: vstup a výstup '" << vystup << "' jsou stejný soubor." << std::endl;
+                return false;
+            }
+            if (vystupni_mapa.namapovano())
+            {
+                kontext.zpracuj_paralelne(vstupni_mapa.data(), vystupni_mapa.data(), vstupni_mapa.velikost(), vlakna);
+                return true;
+            }
+        }
+    }
+
+    std::error_code chyba;
+    if (std::filesystem::equivalent(vstup, vystup, chyba))
+    {
+        // Např. prázdný vstup, který nešel namapovat - std::ofstream by ho zkrátil
+        std::cerr << "Chyba: vstup a výstup '" << vystup << "' jsou stejný soubor." << std::endl;
+        return false;
+    }
+    std::ifstream ifs(vstup, std::ios::in | std::ios::binary);
+    if (!ifs.is_open())
+    {
+        std::cerr << "Chyba: nepodařilo se otevřít soubor '" << vstup << "'." << std::endl;
+        return false;
+    }
+    std::ofstream ofs(vystup, std::ios::out | std::ios::binary);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Chyba: nepodařilo se otevřít soubor '" << vystup << "' pro zápis." << std::endl;
+        return false;
+    }
+
+    std::vector<char> blok(std::max<size_t>(velikost_bloku, 1));
+    while (ifs)
+    {
+        ifs.read(blok.data(), static_cast<std::streamsize>(blok.size()));
+        size_t nacteno = static_cast<size_t>(ifs.gcount());
+        kontext.zpracuj_paralelne(blok.data(), blok.data(), nacteno, vlakna);
+        ofs.write(blok.data(), static_cast<std::streamsize>(nacteno));
+    }
+    if (ifs.bad() || !ofs)
+    {
+        std::cerr << "Chyba: zpracování souboru '" << vstup << "' selhalo." << std::endl;
+        return false;
+    }
+    return true;
+}
 
 /**
- * Funkce pro otevření souboru a načtení jeho obsahu do jednoho řetězce.
- * @param jmeno_souboru Cesta k souboru
- * @return Načtený obsah souboru jako std::string (nebo prázdný řetězec při chybě)
+ * Dávkové šifrování mnoha souborů (celý adresář nebo seznam souborů).
  */
-std::string otevri_soubor(const std::string &jmeno_souboru)
+struct NastaveniDavky
 {
-    std::ifstream ifs(jmeno_souboru, std::ios::in | std::ios::binary);
-    if (!ifs.is_open())
+    unsigned int vlakna = 0;         // vlákna pro šifrování (0 = podle počtu jader)
+    size_t velikost_bloku = 1 << 20; // soubory se čtou, šifrují a zapisují po blocích této velikosti
+    size_t max_v_letu = 64 << 20;    // horní mez paměti ve všech rozpracovaných blocích
+    bool io_uring = true;            // na Linuxu použít io_uring (pokud nejde, použije se fond vláken)
+};
+
+struct VysledekSouboru
+{
+    std::string vstup;
+    std::string vystup;
+    size_t bajtu = 0;
+    double sekundy = 0;
+    bool uspech = false;
+};
+
+struct SouhrnDavky
+{
+    std::vector<VysledekSouboru> soubory; // ve stejném pořadí jako úlohy
+    size_t bajtu = 0;
+    size_t chyb = 0;
+    double sekundy = 0;    // celková doba (ne součet dob souborů, ty se překrývají)
+    bool io_uring = false; // zda se všechny soubory zpracovaly přes io_uring
+};
+
+typedef std::pair<std::string, std::string> UlohaSouboru; // (vstupní soubor, výstupní soubor)
+typedef std::function<std::unique_ptr<SifrovaciKontext>()> TovarnaKontextu;
+
+/**
+ * Úlohy pro všechny běžné soubory v adresáři (i v podadresářích). Výstupní soubory
+ * mají stejnou relativní cestu ve výstupním adresáři. Seřazené podle cesty.
+ */
+std::vector<UlohaSouboru> ulohy_z_adresare(const std::string &adresar, const std::string &vystupni_adresar)
+{
+    std::vector<UlohaSouboru> ulohy;
+    std::error_code chyba;
+    std::filesystem::recursive_directory_iterator it(adresar, chyba);
+    if (chyba)
     {
-        std::cerr << "Chyba: nepodařilo se otevřít soubor '" << jmeno_souboru << "'." << std::endl;
-        return {};
+        std::cerr << "Chyba: nepodařilo se otevřít adresář '" << adresar << "'." << std::endl;
+        return ulohy;
     }
-    // Načteme obsah souboru do řetězce
-    std::string obsah((std::istreambuf_iterator<char>(ifs)),
-                      (std::istreambuf_iterator<char>()));
-    return obsah;
+    for (const std::filesystem::directory_entry &polozka : it)
+    {
+        if (polozka.is_regular_file())
+        {
+            std::filesystem::path relativni = std::filesystem::relative(polozka.path(), adresar);
+            ulohy.emplace_back(polozka.path().string(), (std::filesystem::path(vystupni_adresar) / relativni).string());
+        }
+    }
+    std::sort(ulohy.begin(), ulohy.end());
+    return ulohy;
 }
 
 /**
- * Caesarova šifra pro šifrování/dešifrování.
- *
- * @param text Vstupní text (otevřený nebo zašifrovaný)
- * @param posun Posun (např. 3) – pro dešifrování se použije záporný posun
- *              v případě sifrovat=false.
- * @param sifrovat true -> šifrování, false -> dešifrování
- * @return Výsledný (zašifrovaný či dešifrovaný) text
- *
- * Pozn.: Upravuje pouze písmena [A-Za-z]. Zachovává velikost písmen.
+ * Úlohy ze seznamu souborů (jedna cesta na řádek, prázdné řádky se přeskočí).
+ * Výstup má jméno vstupního souboru ve výstupním adresáři; stejně pojmenované
+ * soubory z různých adresářů tak mají stejný výstup a sifruj_davku zpracuje
+ * jen první z nich (ostatní hlásí jako chybu).
  */
-std::string caesar_sifra(const std::string &text, int posun, bool sifrovat)
+std::vector<UlohaSouboru> ulohy_ze_seznamu(const std::string &seznam, const std::string &vystupni_adresar)
 {
-    // Pokud dešifrujeme, otočíme znaménko posunu
-    if (!sifrovat)
+    std::vector<UlohaSouboru> ulohy;
+    std::ifstream ifs(seznam);
+    if (!ifs.is_open())
     {
-        posun = -posun;
+        std::cerr << "Chyba: nepodařilo se otevřít seznam souborů '" << seznam << "'." << std::endl;
+        return ulohy;
+    }
+    std::string radek;
+    while (std::getline(ifs, radek))
+    {
+        if (!radek.empty() && radek.back() == '\r')
+        {
+            radek.pop_back();
+        }
+        if (!radek.empty())
+        {
+            std::filesystem::path vystup = std::filesystem::path(vystupni_adresar) / std::filesystem::path(radek).filename();
+            ulohy.emplace_back(radek, vystup.string());
+        }
     }
+    return ulohy;
+}
 
-    std::string vystup;
-    vystup.reserve(text.size());
+/**
+ * Omezení paměti v rozpracovaných blocích sdílené mezi vlákny.
+ */
+class RozpocetPameti
+{
+public:
+    explicit RozpocetPameti(size_t limit) : m_volno(limit) {}
 
-    for (char c : text)
+    /** Počká, až bude volných alespoň bajtu bajtů, a zabere je. */
+    void zaber(size_t bajtu)
     {
-        if (std::isalpha(static_cast<unsigned char>(c)))
+        size_t volno = m_volno.load();
+        for (;;)
         {
-            // Rozlišujeme velká a malá písmena
-            if (std::isupper(static_cast<unsigned char>(c)))
+            if (volno < bajtu)
             {
-                // 'A' má kód 65
-                c = static_cast<char>('A' + ( (c - 'A') + posun + 26 ) % 26);
+                m_volno.wait(volno);
+                volno = m_volno.load();
             }
-            else
+            else if (m_volno.compare_exchange_weak(volno, volno - bajtu))
             {
-                // 'a' má kód 97
-                c = static_cast<char>('a' + ( (c - 'a') + posun + 26 ) % 26);
+                return;
             }
         }
-        vystup.push_back(c);
     }
-    return vystup;
+
+    void uvolni(size_t bajtu)
+    {
+        m_volno += bajtu;
+        m_volno.notify_all();
+    }
+
+private:
+    std::atomic<size_t> m_volno;
+};
+
+static double sekund_od(std::chrono::steady_clock::time_point zacatek)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - zacatek).count();
+}
+
+static bool priprav_vystupni_adresar(const std::string &vystup)
+{
+    std::filesystem::path rodic = std::filesystem::path(vystup).parent_path();
+    std::error_code chyba;
+    if (!rodic.empty())
+    {
+        std::filesystem::create_directories(rodic, chyba);
+    }
+    if (chyba)
+    {
+        std::cerr << "Chyba: nepodařilo se vytvořit adresář '" << rodic.string() << "'." << std::endl;
+        return false;
+    }
+    return true;
 }
 
 /**
- * Pomocná funkce k Vigenere – vrací posun podle jednoho znaku klíče.
- * Vycházíme z písmena v klíči (a=0, b=1, ..., z=25).
+ * Záložní cesta: fond vláken, každé vlákno zpracuje celý soubor blokujícím
+ * sifruj_soubor. Vláken je víc než jader, aby se čekání na disk překrývalo
+ * se šifrováním jiných souborů.
+ * @param indexy Které z úloh zpracovat
  */
-static int vigenere_posun(char klic_char)
+static void sifruj_davku_vlakny(const std::vector<UlohaSouboru> &ulohy, const std::vector<size_t> &indexy,
+                                const TovarnaKontextu &tovarna, const NastaveniDavky &nastaveni, SouhrnDavky &souhrn)
 {
-    // Budeme pracovat v malých písmenech
-    klic_char = static_cast<char>(std::tolower(static_cast<unsigned char>(klic_char)));
-    return (klic_char - 'a') % 26; // posun 0..25
+    unsigned int vlakna = nastaveni.vlakna;
+    if (vlakna == 0)
+    {
+        vlakna = std::max(4u, 2 * std::thread::hardware_concurrency());
+    }
+    vlakna = static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(vlakna, indexy.size())));
+    const size_t blok = std::max<size_t>(1, std::min(nastaveni.velikost_bloku, nastaveni.max_v_letu));
+    RozpocetPameti rozpocet(std::max(nastaveni.max_v_letu, blok));
+
+    std::atomic<size_t> dalsi(0);
+    paralelne(vlakna, [&](unsigned int) {
+        for (size_t j = dalsi++; j < indexy.size(); j = dalsi++)
+        {
+            size_t i = indexy[j];
+            VysledekSouboru &vysledek = souhrn.soubory[i];
+            auto zacatek = std::chrono::steady_clock::now();
+            std::error_code chyba;
+            uintmax_t velikost = std::filesystem::file_size(ulohy[i].first, chyba);
+            size_t pamet = chyba ? blok : static_cast<size_t>(std::min<uintmax_t>(std::max<uintmax_t>(velikost, 1), blok));
+            rozpocet.zaber(pamet);
+            std::unique_ptr<SifrovaciKontext> kontext = tovarna();
+            vysledek.uspech = priprav_vystupni_adresar(ulohy[i].second) &&
+                              sifruj_soubor(ulohy[i].first, ulohy[i].second, *kontext, pamet, 1);
+            rozpocet.uvolni(pamet);
+            vysledek.bajtu = vysledek.uspech && !chyba ? static_cast<size_t>(velikost) : 0;
+            vysledek.sekundy = sekund_od(zacatek);
+        }
+    });
 }
 
+#ifdef SIFRY_IO_URING
 /**
- * Vigenere šifra pro šifrování/dešifrování.
- * @param text Vstupní text (otevřený nebo zašifrovaný)
- * @param klic Klíčové slovo (např. "tajne")
- * @param sifrovat true -> šifrování, false -> dešifrování
- * @return Výsledný zašifrovaný nebo dešifrovaný text
- *
- * Pozn.: Upravuje pouze písmena [A-Za-z]. Zachovává velikost písmen.
+ * Minimální obal io_uring přímo nad systémovými voláními (bez liburing):
+ * fronta požadavků (SQ) a fronta dokončení (CQ) sdílené s jádrem přes mmap.
+ * Používá ho jen jedno vlákno.
  */
-std::string vigener_sifra(const std::string &text, const std::string &klic, bool sifrovat)
+class IoUring
 {
-    if (klic.empty())
+public:
+    explicit IoUring(unsigned int hloubka)
     {
-        // Bez klíče nic neděláme, vrátíme text beze změn
-        return text;
+        io_uring_params parametry;
+        std::memset(&parametry, 0, sizeof(parametry));
+        m_fd = static_cast<int>(syscall(__NR_io_uring_setup, hloubka, &parametry));
+        if (m_fd < 0)
+        {
+            return;
+        }
+        // IORING_OP_READ/WRITE přibyly ve stejné verzi jádra (5.6) jako tento příznak
+        if (!(parametry.features & IORING_FEAT_RW_CUR_POS))
+        {
+            zavri();
+            return;
+        }
+
+        m_velikost_sq = parametry.sq_off.array + parametry.sq_entries * sizeof(unsigned int);
+        m_velikost_cq = parametry.cq_off.cqes + parametry.cq_entries * sizeof(io_uring_cqe);
+        bool jedno_mapovani = parametry.features & IORING_FEAT_SINGLE_MMAP;
+        if (jedno_mapovani)
+        {
+            m_velikost_sq = m_velikost_cq = std::max(m_velikost_sq, m_velikost_cq);
+        }
+        m_sq = mmap(nullptr, m_velikost_sq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        m_cq = jedno_mapovani ? m_sq
+                              : mmap(nullptr, m_velikost_cq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        m_velikost_sqe = parametry.sq_entries * sizeof(io_uring_sqe);
+        m_sqe = static_cast<io_uring_sqe *>(
+            mmap(nullptr, m_velikost_sqe, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+        if (m_sq == MAP_FAILED || m_cq == MAP_FAILED || m_sqe == MAP_FAILED)
+        {
+            zavri();
+            return;
+        }
+
+        char *sq = static_cast<char *>(m_sq);
+        char *cq = static_cast<char *>(m_cq);
+        m_sq_hlava = reinterpret_cast<unsigned int *>(sq + parametry.sq_off.head);
+        m_sq_konec = reinterpret_cast<unsigned int *>(sq + parametry.sq_off.tail);
+        m_sq_maska = *reinterpret_cast<unsigned int *>(sq + parametry.sq_off.ring_mask);
+        m_sq_pole = reinterpret_cast<unsigned int *>(sq + parametry.sq_off.array);
+        m_cq_hlava = reinterpret_cast<unsigned int *>(cq + parametry.cq_off.head);
+        m_cq_konec = reinterpret_cast<unsigned int *>(cq + parametry.cq_off.tail);
+        m_cq_maska = *reinterpret_cast<unsigned int *>(cq + parametry.cq_off.ring_mask);
+        m_cqe = reinterpret_cast<io_uring_cqe *>(cq + parametry.cq_off.cqes);
+        m_kapacita = parametry.sq_entries;
+        m_konec = *m_sq_konec;
     }
 
-    std::string vystup;
-    vystup.reserve(text.size());
+    ~IoUring()
+    {
+        zavri();
+    }
+
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    bool funguje() const
+    {
+        return m_fd >= 0;
+    }
+
+    /** Přidá čtení nebo zápis (IORING_OP_READ/WRITE) do fronty; odešle se v cekej(). */
+    void pridej(unsigned char operace, int fd, void *data, size_t delka, uint64_t pozice, void *uloha)
+    {
+        unsigned int index = m_konec & m_sq_maska;
+        io_uring_sqe &sqe = m_sqe[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = operace;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64_t>(data);
+        sqe.len = static_cast<unsigned int>(std::min<size_t>(delka, 1u << 30));
+        sqe.off = pozice;
+        sqe.user_data = reinterpret_cast<uint64_t>(uloha);
+        m_sq_pole[index] = index;
+        m_konec++;
+        m_k_odeslani++;
+    }
+
+    /** Volná místa ve frontě požadavků. */
+    unsigned int volno() const
+    {
+        return m_kapacita - (m_konec - __atomic_load_n(m_sq_hlava, __ATOMIC_ACQUIRE));
+    }
+
+    /** Odešle přidané požadavky a počká na alespoň jedno dokončení. */
+    bool cekej()
+    {
+        __atomic_store_n(m_sq_konec, m_konec, __ATOMIC_RELEASE);
+        for (;;)
+        {
+            long vysledek = syscall(__NR_io_uring_enter, m_fd, m_k_odeslani, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (vysledek >= 0)
+            {
+                m_k_odeslani -= std::min<unsigned int>(m_k_odeslani, static_cast<unsigned int>(vysledek));
+                return true;
+            }
+            if (errno != EINTR)
+            {
+                return false;
+            }
+        }
+    }
 
-    int klic_delka = static_cast<int>(klic.size());
-    int j = 0; // index pro procházení klíče
+    /** Vyzvedne jedno dokončení; false, pokud žádné není. */
+    bool vyzvedni(uint64_t &uloha, int &vysledek)
+    {
+        unsigned int hlava = *m_cq_hlava;
+        if (hlava == __atomic_load_n(m_cq_konec, __ATOMIC_ACQUIRE))
+        {
+            return false;
+        }
+        const io_uring_cqe &cqe = m_cqe[hlava & m_cq_maska];
+        uloha = cqe.user_data;
+        vysledek = cqe.res;
+        __atomic_store_n(m_cq_hlava, hlava + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    void zavri()
+    {
+        if (m_sqe != nullptr && m_sqe != MAP_FAILED)
+        {
+            munmap(m_sqe, m_velikost_sqe);
+        }
+        if (m_cq != nullptr && m_cq != MAP_FAILED && m_cq != m_sq)
+        {
+            munmap(m_cq, m_velikost_cq);
+        }
+        if (m_sq != nullptr && m_sq != MAP_FAILED)
+        {
+            munmap(m_sq, m_velikost_sq);
+        }
+        m_sq = m_cq = nullptr;
+        m_sqe = nullptr;
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+        m_fd = -1;
+    }
+
+    int m_fd = -1;
+    void *m_sq = nullptr;
+    void *m_cq = nullptr;
+    io_uring_sqe *m_sqe = nullptr;
+    size_t m_velikost_sq = 0;
+    size_t m_velikost_cq = 0;
+    size_t m_velikost_sqe = 0;
+    unsigned int *m_sq_hlava = nullptr;
+    unsigned int *m_sq_konec = nullptr;
+    unsigned int *m_sq_pole = nullptr;
+    unsigned int m_sq_maska = 0;
+    unsigned int *m_cq_hlava = nullptr;
+    unsigned int *m_cq_konec = nullptr;
+    unsigned int m_cq_maska = 0;
+    io_uring_cqe *m_cqe = nullptr;
+    unsigned int m_kapacita = 0;
+    unsigned int m_konec = 0;
+    unsigned int m_k_odeslani = 0;
+};
+
+/**
+ * Soubor rozpracovaný v io_uring smyčce. Každý soubor má v letu nejvýše jednu
+ * operaci (čtení bloku, šifrování, nebo zápis), bloky jednoho souboru tak
+ * procházejí šifrou popořadě a stav kontextu se přenáší správně.
+ */
+struct RozpracovanySoubor
+{
+    size_t index;
+    int vstup_fd = -1;
+    int vystup_fd = -1;
+    size_t velikost = 0;
+    size_t pozice = 0;     // začátek aktuálního bloku v souboru
+    size_t v_bloku = 0;    // délka aktuálního bloku
+    size_t hotovo = 0;     // kolik bajtů bloku je už přečteno / zapsáno
+    bool zapisuje = false; // false = čte blok, true = zapisuje blok
+    std::vector<char> blok;
+    std::unique_ptr<SifrovaciKontext> kontext;
+    std::chrono::steady_clock::time_point zacatek;
+
+    ~RozpracovanySoubor()
+    {
+        // Jen při předčasném ukončení smyčky; normálně zavře soubory dokonci()
+        if (vstup_fd >= 0)
+        {
+            close(vstup_fd);
+        }
+        if (vystup_fd >= 0)
+        {
+            close(vystup_fd);
+        }
+    }
+};
+
+/**
+ * io_uring cesta: jedno vlákno (volající) otevírá soubory a zadává čtení a zápisy
+ * do io_uring, šifrování bloků běží ve fondu vláken. Vlákna hlásí hotové bloky
+ * přes eventfd, jehož čtení je také v io_uring, takže smyčka čeká jen na jednom
+ * místě. Počet současně otevřených souborů omezuje max_v_letu / velikost bloku
+ * a hloubka fronty.
+ * @param indexy Které z úloh zpracovat
+ * @return Indexy úloh, které se nedokončily, protože io_uring nejde použít nebo
+ *         selhal (volající je zpracuje fondem vláken); prázdný = vše zpracováno
+ */
+static std::vector<size_t> sifruj_davku_io_uring(const std::vector<UlohaSouboru> &ulohy, const std::vector<size_t> &indexy,
+                                                 const TovarnaKontextu &tovarna, const NastaveniDavky &nastaveni,
+                                                 SouhrnDavky &souhrn)
+{
+    // Bloky a čítač eventfd musí přežít ring: jádro do nich může zapisovat, dokud se nezavře
+    std::vector<std::unique_ptr<RozpracovanySoubor>> rozpracovane(ulohy.size());
+    uint64_t udalosti = 0;
+    const unsigned int HLOUBKA = 256;
+    IoUring ring(HLOUBKA);
+    if (!ring.funguje())
+    {
+        return indexy;
+    }
+    int udalost_fd = eventfd(0, EFD_CLOEXEC);
+    if (udalost_fd < 0)
+    {
+        return indexy;
+    }
+
+    // Fond vláken pro šifrování
+    std::mutex zamek;
+    std::counting_semaphore<> je_prace(0); // počet bloků ve frontě (a po skončení počet vláken)
+    std::deque<RozpracovanySoubor *> k_sifrovani;
+    std::vector<RozpracovanySoubor *> zasifrovane;
+    unsigned int vlakna = nastaveni.vlakna != 0 ? nastaveni.vlakna : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> fond;
+    for (unsigned int v = 0; v < vlakna; v++)
+    {
+        fond.emplace_back([&] {
+            std::unique_lock<std::mutex> z(zamek, std::defer_lock);
+            for (;;)
+            {
+                je_prace.acquire();
+                z.lock();
+                if (k_sifrovani.empty())
+                {
+                    return; // semafor uvolněný na konci, práce už nebude
+                }
+                RozpracovanySoubor *soubor = k_sifrovani.front();
+                k_sifrovani.pop_front();
+                z.unlock();
+                soubor->kontext->zpracuj(soubor->blok.data(), soubor->blok.data(), soubor->v_bloku);
+                z.lock();
+                zasifrovane.push_back(soubor);
+                uint64_t jedna = 1;
+                ssize_t zapsano = write(udalost_fd, &jedna, sizeof(jedna));
+                (void)zapsano; // zápis do eventfd selže jen při přetečení čítače
+                z.unlock();
+            }
+        });
+    }
+
+    const size_t blok = std::max<size_t>(1, std::min(nastaveni.velikost_bloku, nastaveni.max_v_letu));
+    size_t volna_pamet = std::max(nastaveni.max_v_letu, blok);
+    size_t dalsi = 0; // pozice v indexy
+    size_t aktivnich = 0;
+    ring.pridej(IORING_OP_READ, udalost_fd, &udalosti, sizeof(udalosti), 0, nullptr);
+    size_t v_letu = 1; // operace zadané do io_uring a ještě nedokončené
+
+    auto zadej_cteni = [&](RozpracovanySoubor *s) {
+        s->zapisuje = false;
+        ring.pridej(IORING_OP_READ, s->vstup_fd, s->blok.data() + s->hotovo, s->v_bloku - s->hotovo, s->pozice + s->hotovo, s);
+        v_letu++;
+    };
+    auto zadej_zapis = [&](RozpracovanySoubor *s) {
+        s->zapisuje = true;
+        ring.pridej(IORING_OP_WRITE, s->vystup_fd, s->blok.data() + s->hotovo, s->v_bloku - s->hotovo, s->pozice + s->hotovo, s);
+        v_letu++;
+    };
+    auto dokonci = [&](RozpracovanySoubor *s, bool uspech) {
+        VysledekSouboru &vysledek = souhrn.soubory[s->index];
+        close(s->vstup_fd);
+        s->vstup_fd = -1;
+        if (s->vystup_fd >= 0 && close(s->vystup_fd) != 0)
+        {
+            uspech = false;
+        }
+        s->vystup_fd = -1;
+        if (!uspech)
+        {
+            std::cerr << "Chyba: zpracování souboru '" << vysledek.vstup << "' selhalo." << std::endl;
+        }
+        vysledek.uspech = uspech;
+        vysledek.bajtu = uspech ? s->velikost : 0;
+        vysledek.sekundy = sekund_od(s->zacatek);
+        volna_pamet += s->blok.capacity();
+        aktivnich--;
+        rozpracovane[s->index].reset();
+    };
+    // Další blok souboru, nebo konec souboru
+    auto dalsi_blok = [&](RozpracovanySoubor *s) {
+        s->pozice += s->v_bloku;
+        s->hotovo = 0;
+        s->v_bloku = std::min(blok, s->velikost - s->pozice);
+        if (s->v_bloku == 0)
+        {
+            dokonci(s, true);
+            return;
+        }
+        zadej_cteni(s);
+    };
 
-    for (char c : text)
+    bool ring_ok = true;
+    while (ring_ok && (dalsi < indexy.size() || aktivnich > 0))
     {
-        if (std::isalpha(static_cast<unsigned char>(c)))
+        // Otevření dalších souborů, dokud stačí paměť a místo ve frontě
+        while (dalsi < indexy.size() && aktivnich + 2 < HLOUBKA && ring.volno() > 0)
         {
-            // Zjistíme posun z písmena klíče
-            int posun = vigenere_posun(klic[j % klic_delka]);
+            const size_t index = indexy[dalsi];
+            const UlohaSouboru &uloha = ulohy[index];
+            struct stat info;
+            int vstup_fd = open(uloha.first.c_str(), O_RDONLY | O_CLOEXEC);
+            if (vstup_fd < 0 || fstat(vstup_fd, &info) != 0 || !S_ISREG(info.st_mode))
+            {
+                std::cerr << "Chyba: nepodařilo se otevřít soubor '" << uloha.first << "'." << std::endl;
+                if (vstup_fd >= 0)
+                {
+                    close(vstup_fd);
+                }
+                dalsi++;
+                continue;
+            }
+            size_t velikost = static_cast<size_t>(info.st_size);
+            size_t pamet = std::min(blok, velikost);
+            if (pamet > volna_pamet && aktivnich > 0)
+            {
+                close(vstup_fd);
+                break; // počkáme, až se paměť uvolní
+            }
+            dalsi++;
 
-            if (!sifrovat)
+            rozpracovane[index] = std::make_unique<RozpracovanySoubor>();
+            RozpracovanySoubor *s = rozpracovane[index].get();
+            s->index = index;
+            s->zacatek = std::chrono::steady_clock::now();
+            s->vstup_fd = vstup_fd;
+            s->velikost = velikost;
+            aktivnich++;
+            // Bez O_TRUNC: výstup se zkrátí až po kontrole, že to není vstup
+            struct stat vystup_info;
+            if (!priprav_vystupni_adresar(uloha.second) ||
+                (s->vystup_fd = open(uloha.second.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644)) < 0 ||
+                fstat(s->vystup_fd, &vystup_info) != 0)
+            {
+                std::cerr << "Chyba: nepodařilo se otevřít soubor '" << uloha.second << "' pro zápis." << std::endl;
+                dokonci(s, false);
+                continue;
+            }
+            if (vystup_info.st_dev == info.st_dev && vystup_info.st_ino == info.st_ino)
+            {
+                std::cerr << "Chyba: vstup a výstup '" << uloha.second << "' jsou stejný soubor." << std::endl;
+                dokonci(s, false);
+                continue;
+            }
+            if (S_ISREG(vystup_info.st_mode) && ftruncate(s->vystup_fd, 0) != 0)
             {
-                // Dešifrování => posun záporný
-                posun = -posun;
+                std::cerr << "Chyba: nepodařilo se zkrátit soubor '" << uloha.second << "'." << std::endl;
+                dokonci(s, false);
+                continue;
             }
+            s->kontext = tovarna();
+            s->blok.reserve(pamet);
+            s->blok.resize(pamet);
+            volna_pamet -= std::min(volna_pamet, s->blok.capacity());
+            s->v_bloku = 0;
+            dalsi_blok(s);
+        }
+
+        if (aktivnich == 0)
+        {
+            // Všechny otevřené soubory skončily (např. hned chybou); v letu je
+            // nanejvýš čtení eventfd, na které by se čekalo donekonečna
+            continue;
+        }
+        ring_ok = ring.cekej();
 
-            // Rozlišujeme velká/malá písmena
-            if (std::isupper(static_cast<unsigned char>(c)))
+        uint64_t data;
+        int vysledek;
+        while (ring_ok && ring.vyzvedni(data, vysledek))
+        {
+            v_letu--;
+            RozpracovanySoubor *s = reinterpret_cast<RozpracovanySoubor *>(data);
+            if (s == nullptr)
+            {
+                // Hotové bloky z fondu vláken jdou k zápisu
+                std::vector<RozpracovanySoubor *> hotove;
+                {
+                    std::lock_guard<std::mutex> z(zamek);
+                    hotove.swap(zasifrovane);
+                }
+                for (RozpracovanySoubor *h : hotove)
+                {
+                    h->hotovo = 0;
+                    zadej_zapis(h);
+                }
+                ring.pridej(IORING_OP_READ, udalost_fd, &udalosti, sizeof(udalosti), 0, nullptr);
+                v_letu++;
+                continue;
+            }
+            if (vysledek < 0 || (vysledek == 0 && s->hotovo < s->v_bloku))
+            {
+                // Chyba, nebo se soubor během čtení zkrátil
+                dokonci(s, false);
+                continue;
+            }
+            s->hotovo += static_cast<size_t>(vysledek);
+            if (s->hotovo < s->v_bloku)
+            {
+                // Neúplné čtení nebo zápis: pokračujeme zbytkem
+                s->zapisuje ? zadej_zapis(s) : zadej_cteni(s);
+            }
+            else if (!s->zapisuje)
             {
-                c = static_cast<char>('A' + ((c - 'A') + posun + 26) % 26);
+                {
+                    std::lock_guard<std::mutex> z(zamek);
+                    k_sifrovani.push_back(s);
+                }
+                je_prace.release();
             }
             else
             {
-                c = static_cast<char>('a' + ((c - 'a') + posun + 26) % 26);
+                dalsi_blok(s);
             }
+        }
+    }
+
+    je_prace.release(static_cast<std::ptrdiff_t>(fond.size()));
+    for (std::thread &vlakno : fond)
+    {
+        vlakno.join();
+    }
+    close(udalost_fd);
 
-            j++;
+    // Po selhání ringu zbývají rozpracované a dosud neotevřené soubory; hotové
+    // (i neúspěšné) soubory už mají výsledek a znovu se nezpracují
+    std::vector<size_t> nedokoncene;
+    for (size_t j = 0; !ring_ok && j < indexy.size(); j++)
+    {
+        if (j >= dalsi || rozpracovane[indexy[j]] != nullptr)
+        {
+            nedokoncene.push_back(indexy[j]);
         }
-        vystup.push_back(c);
     }
-    return vystup;
+    // Ring se zavře v destruktoru (před bloky); nedokončené operace jádro zruší
+    return nedokoncene;
 }
+#endif // SIFRY_IO_URING
 
 /**
- * XOR šifra: provádí XOR s heslem pro každý znak.
- * Protože XOR je inverzní sama sobě, funkce je stejná pro šifrování i dešifrování.
+ * Zašifruje dávku souborů. Čtení, šifrování a zápis různých souborů se překrývají
+ * (na Linuxu přes io_uring, jinak fondem vláken), paměť v rozpracovaných blocích
+ * nepřekročí nastaveni.max_v_letu (jeden blok se zpracuje vždy, i když je větší).
  *
- * @param text Vstupní text
- * @param klic Klíč (heslo) – zpracovává se po znacích (cyklicky)
- * @param sifrovat true -> "šifruj", false -> "dešifruj" (ve skutečnosti je to totéž)
- * @return Text po XOR operaci
+ * @param ulohy Dvojice (vstup, výstup), např. z ulohy_z_adresare. Úlohy se stejným
+ *              výstupním souborem jako některá předchozí úloha se nezpracují a hlásí se jako chyba.
+ * @param tovarna Vytvoří pro každý soubor nový kontext (šifrování začíná od začátku klíče)
+ * @return Výsledek pro každý soubor a celkový souhrn
  */
-std::string xor_sifra(const std::string &text, const std::string &klic, bool /*sifrovat*/)
+SouhrnDavky sifruj_davku(const std::vector<UlohaSouboru> &ulohy, const TovarnaKontextu &tovarna,
+                         const NastaveniDavky &nastaveni = NastaveniDavky())
 {
-    if (klic.empty())
+    auto zacatek = std::chrono::steady_clock::now();
+    SouhrnDavky souhrn;
+    souhrn.soubory.resize(ulohy.size());
+    for (size_t i = 0; i < ulohy.size(); i++)
     {
-        // Bez klíče nic neděláme
-        return text;
+        souhrn.soubory[i].vstup = ulohy[i].first;
+        souhrn.soubory[i].vystup = ulohy[i].second;
+    }
+
+    // Dvě úlohy se stejným výstupem by zapisovaly do jednoho souboru současně
+    std::vector<size_t> zbyva;
+    std::set<std::filesystem::path> vystupy;
+    for (size_t i = 0; i < ulohy.size(); i++)
+    {
+        std::error_code chyba;
+        std::filesystem::path vystup = std::filesystem::absolute(ulohy[i].second, chyba).lexically_normal();
+        if (!vystupy.insert(chyba ? std::filesystem::path(ulohy[i].second) : vystup).second)
+        {
+            std::cerr << "Chyba: do souboru '" << ulohy[i].second << "' už zapisuje jiný vstupní soubor, '"
+                      << ulohy[i].first << "' se přeskočí." << std::endl;
+            continue;
+        }
+        zbyva.push_back(i);
+    }
+#ifdef SIFRY_IO_URING
+    if (nastaveni.io_uring)
+    {
+        zbyva = sifruj_davku_io_uring(ulohy, zbyva, tovarna, nastaveni, souhrn);
+        souhrn.io_uring = zbyva.empty();
+    }
+#endif
+    if (!zbyva.empty())
+    {
+        sifruj_davku_vlakny(ulohy, zbyva, tovarna, nastaveni, souhrn);
     }
 
-    std::string vystup = text; // upravujeme kopii
-    for (size_t i = 0; i < vystup.size(); i++)
+    for (const VysledekSouboru &vysledek : souhrn.soubory)
     {
-        // Klíč se opakuje cyklicky
-        char k = klic[i % klic.size()];
-        // Provedeme XOR: result = original ^ key
-        vystup[i] = static_cast<char>(vystup[i] ^ k);
+        souhrn.bajtu += vysledek.bajtu;
+        souhrn.chyb += vysledek.uspech ? 0 : 1;
     }
+    souhrn.sekundy = sekund_od(zacatek);
+    return souhrn;
+}
 
-    return vystup;
+static double mb_za_sekundu(size_t bajtu, double sekundy)
+{
+    return sekundy > 0 ? static_cast<double>(bajtu) / 1e6 / sekundy : 0;
 }
 
 /**
- * Uloží daný řetězec do zadaného souboru. Pokud se nepodaří otevřít, vypíše chybu.
- * @param jmeno_souboru Název/cesta k souboru
- * @param obsah Řetězec k uložení
+ * Vypíše propustnost každého souboru a celé dávky.
  */
-void uloz_do_souboru(const std::string &jmeno_souboru, const std::string &obsah)
+void vypis_souhrn(std::ostream &os, const SouhrnDavky &souhrn)
 {
-    std::ofstream ofs(jmeno_souboru, std::ios::out | std::ios::binary);
-    if (!ofs.is_open())
+    for (const VysledekSouboru &vysledek : souhrn.soubory)
     {
-        std::cerr << "Chyba: nepodařilo se otevřít soubor '" << jmeno_souboru << "' pro zápis." << std::endl;
-        return;
+        os << vysledek.vstup << ": ";
+        if (!vysledek.uspech)
+        {
+            os << "CHYBA" << std::endl;
+            continue;
+        }
+        os << vysledek.bajtu << " B, " << vysledek.sekundy * 1000 << " ms, "
+           << mb_za_sekundu(vysledek.bajtu, vysledek.sekundy) << " MB/s" << std::endl;
     }
-    ofs.write(obsah.data(), static_cast<std::streamsize>(obsah.size()));
+    os << "Celkem: " << souhrn.soubory.size() << " souboru (" << souhrn.chyb << " chyb), " << souhrn.bajtu << " B za "
+       << souhrn.sekundy * 1000 << " ms, " << mb_za_sekundu(souhrn.bajtu, souhrn.sekundy) << " MB/s"
+       << (souhrn.io_uring ? " (io_uring)" : " (vlakna)") << std::endl;
 }
 
 #ifndef __TEST__
-int main()
+/**
+ * Dávkový režim: sifry <adresar | @seznam.txt> <vystupni_adresar> <caesar|vigener|xor> <posun|klic> [desifrovat]
+ */
+static int davkovy_rezim(int argc, char *argv[])
+{
+    std::string vstup = argv[1];
+    std::string vystupni_adresar = argv[2];
+    std::string sifra = argv[3];
+    std::string klic = argv[4];
+    bool sifrovat = !(argc > 5 && std::string(argv[5]) == "desifrovat");
+
+    TovarnaKontextu tovarna;
+    if (sifra == "caesar")
+    {
+        int posun = 0;
+        auto [konec, chyba] = std::from_chars(klic.data(), klic.data() + klic.size(), posun);
+        if (chyba != std::errc() || konec != klic.data() + klic.size())
+        {
+            std::cerr << "Neplatny posun '" << klic << "' (ocekavano cele cislo)." << std::endl;
+            return 1;
+        }
+        tovarna = [=]() { return std::make_unique<CaesarKontext>(posun, sifrovat); };
+    }
+    else if (sifra == "vigener")
+    {
+        tovarna = [=]() { return std::make_unique<VigenerKontext>(klic, sifrovat); };
+    }
+    else if (sifra == "xor")
+    {
+        tovarna = [=]() { return std::make_unique<XorKontext>(klic); };
+    }
+    else
+    {
+        std::cerr << "Neznama sifra '" << sifra << "' (caesar, vigener nebo xor)." << std::endl;
+        return 1;
+    }
+
+    std::vector<UlohaSouboru> ulohy = vstup.starts_with("@") ? ulohy_ze_seznamu(vstup.substr(1), vystupni_adresar)
+                                                             : ulohy_z_adresare(vstup, vystupni_adresar);
+    SouhrnDavky souhrn = sifruj_davku(ulohy, tovarna);
+    vypis_souhrn(std::cout, souhrn);
+    return souhrn.chyb == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
 {
+    if (argc >= 5)
+    {
+        return davkovy_rezim(argc, argv);
+    }
+
     // 1) Načtení vstupního souboru
     std::string vstupni_text = otevri_soubor("vstup.txt");
     std::cout << "Nacteno " << vstupni_text.size() << " znaku z 'vstup.txt'." << std::endl;
@@ -203,18 +2359,32 @@ int main()
     uloz_do_souboru("sifrovany_xor.txt", sifrovany_text_xor);
 
     // 6) Dešifrování textů (pokud jsme uložili do souboru, musíme je znovu načíst z disku)
-    std::string nacteny_caesar = otevri_soubor("sifrovany_caesar.txt");
-    std::string desifrovany_caesar = caesar_sifra(nacteny_caesar, 3, false);
+    //    Načtený text se dešifruje na místě, bez dalšího bufferu
+    std::string desifrovany_caesar = otevri_soubor("sifrovany_caesar.txt");
+    caesar_sifra(std::span<char>(desifrovany_caesar), 3, false);
     std::cout << "Dešifrovaný text (Caesar): " << desifrovany_caesar.substr(0, 50) << " ..." << std::endl;
 
-    std::string nacteny_vigener = otevri_soubor("sifrovany_vigener.txt");
-    std::string desifrovany_vigener = vigener_sifra(nacteny_vigener, "tajny_klic", false);
+    std::string desifrovany_vigener = otevri_soubor("sifrovany_vigener.txt");
+    vigener_sifra(std::span<char>(desifrovany_vigener), "tajny_klic", false);
     std::cout << "Dešifrovaný text (Vigener): " << desifrovany_vigener.substr(0, 50) << " ..." << std::endl;
 
-    std::string nacteny_xor = otevri_soubor("sifrovany_xor.txt");
-    std::string desifrovany_xor = xor_sifra(nacteny_xor, "heslo", false);
+    std::string desifrovany_xor = otevri_soubor("sifrovany_xor.txt");
+    xor_sifra(std::span<char>(desifrovany_xor), "heslo", false);
     std::cout << "Dešifrovaný text (XOR): " << desifrovany_xor.substr(0, 50) << " ..." << std::endl;
 
+    // 7) Vrstvené šifrování (Vigener a potom XOR) jedním průchodem a zpět inverzním řetězcem
+    SifrovaciRetezec retezec;
+    retezec.pridej(std::make_unique<VigenerKontext>("tajny_klic", true)).pridej(std::make_unique<XorKontext>("heslo"));
+    std::unique_ptr<SifrovaciKontext> zpet = retezec.inverzni();
+    std::string vrstveny = vstupni_text;
+    retezec.zpracuj(vrstveny.data(), vrstveny.data(), vrstveny.size());
+    zpet->zpracuj(vrstveny.data(), vrstveny.data(), vrstveny.size());
+    std::cout << "Vrstvene sifrovani a zpet: " << (vrstveny == vstupni_text ? "shoda" : "CHYBA") << std::endl;
+
+    // 8) Odhad ztraceného klíče Caesarovy šifry ze šifrovaného textu
+    std::vector<KandidatCaesar> kandidati = prolom_caesar(sifrovany_text_caesar);
+    std::cout << "Odhadnuty posun Caesarovy sifry: " << kandidati[0].posun << std::endl;
+
     return 0;
 }
 #endif // __TEST__
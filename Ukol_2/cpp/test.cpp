@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "sifry.cpp" // Předpokládám, že kód je v souboru vypocty.cpp
+#include "kryptoanalyza.cpp"
 
 TEST(SifrovaciAlgoritmyTest, OtevriSoubor)
 {
@@ -69,4 +70,583 @@ TEST(SifrovaciAlgoritmyTest, UlozDoSouboru)
 
     // Vyčištění - odstranění testovacího souboru
     remove(jmeno_souboru.c_str());
-}
\ No newline at end of file
+}
+
+// Původní implementace po znacích - referenční výstup pro vektorová jádra
+static std::string caesar_puvodni(const std::string &text, int posun, bool sifrovat)
+{
+    if (!sifrovat)
+    {
+        posun = -posun;
+    }
+    std::string vystup;
+    for (char c : text)
+    {
+        if (std::isalpha(static_cast<unsigned char>(c)))
+        {
+            char zaklad = std::isupper(static_cast<unsigned char>(c)) ? 'A' : 'a';
+            c = static_cast<char>(zaklad + ((c - zaklad) + posun + 26) % 26);
+        }
+        vystup.push_back(c);
+    }
+    return vystup;
+}
+
+static std::string vigener_puvodni(const std::string &text, const std::string &klic, bool sifrovat)
+{
+    std::string vystup;
+    int j = 0;
+    for (char c : text)
+    {
+        if (std::isalpha(static_cast<unsigned char>(c)))
+        {
+            int posun = vigenere_posun(klic[j % klic.size()]);
+            if (!sifrovat)
+            {
+                posun = -posun;
+            }
+            char zaklad = std::isupper(static_cast<unsigned char>(c)) ? 'A' : 'a';
+            c = static_cast<char>(zaklad + ((c - zaklad) + posun + 26) % 26);
+            j++;
+        }
+        vystup.push_back(c);
+    }
+    return vystup;
+}
+
+// Pseudonáhodný text se všemi hodnotami bajtů, s úseky samých písmen
+static std::string nahodny_text(size_t delka, unsigned int stav)
+{
+    std::string text(delka, '\0');
+    for (size_t i = 0; i < delka; i++)
+    {
+        stav = stav * 1103515245u + 12345u;
+        text[i] = ((i / 64) % 2 == 0) ? static_cast<char>('a' + (stav >> 16) % 26)
+                                      : static_cast<char>(stav >> 16);
+    }
+    return text;
+}
+
+TEST(SifrovaciAlgoritmyTest, VektoroveJadraShodnaSPuvodnim)
+{
+    std::string text = nahodny_text(1000, 42);
+    for (int posun = -60; posun <= 60; posun++)
+    {
+        ASSERT_EQ(caesar_sifra(text, posun, true), caesar_puvodni(text, posun, true)) << "posun = " << posun;
+        ASSERT_EQ(caesar_sifra(text, posun, false), caesar_puvodni(text, posun, false)) << "posun = " << posun;
+    }
+    for (const std::string klic : {"tajny_klic", "heslo", "Z", "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGH"})
+    {
+        ASSERT_EQ(vigener_sifra(text, klic, true), vigener_puvodni(text, klic, true)) << "klic = " << klic;
+        ASSERT_EQ(vigener_sifra(text, klic, false), vigener_puvodni(text, klic, false)) << "klic = " << klic;
+    }
+}
+
+TEST(SifrovaciAlgoritmyTest, VsechnaVektorovaJadra)
+{
+    std::vector<CaesarJadro> caesar = {caesar_skalar};
+    std::vector<VigenerJadro> vigener = {vigener_skalar};
+#ifdef SIFRY_X86_SIMD
+    caesar.push_back(caesar_sse2);
+    vigener.push_back(vigener_sse2);
+    if (__builtin_cpu_supports("avx2"))
+    {
+        caesar.push_back(caesar_avx2);
+        vigener.push_back(vigener_avx2);
+    }
+#endif
+    std::string text = nahodny_text(517, 7);
+    std::vector<unsigned char> posuny = priprav_posuny("tajny_klic", true);
+    VigenerKlic klic = {posuny.data(), 10};
+    for (size_t i = 1; i < caesar.size(); i++)
+    {
+        std::string a(text.size(), '\0'), b(text.size(), '\0');
+        caesar[0](text.data(), &a[0], text.size(), 11);
+        caesar[i](text.data(), &b[0], text.size(), 11);
+        EXPECT_EQ(a, b);
+        // Začátek uprostřed klíče
+        EXPECT_EQ(vigener[0](text.data(), &a[0], text.size(), klic, 3),
+                  vigener[i](text.data(), &b[0], text.size(), klic, 3));
+        EXPECT_EQ(a, b);
+    }
+}
+
+TEST(SifrovaciAlgoritmyTest, KontextyPoBlocich)
+{
+    std::string text = nahodny_text(5000, 3);
+    std::string klic = "tajny_klic";
+
+    CaesarKontext caesar(3, true);
+    VigenerKontext vigener(klic, true);
+    XorKontext xor_kontext("heslo");
+    std::string a = text, b = text, c = text;
+    // Nepravidelné bloky - stav se musí přenést přes hranice bloků
+    for (size_t od = 0, blok = 1; od < text.size(); od += blok, blok = blok * 3 % 97 + 1)
+    {
+        size_t n = std::min(blok, text.size() - od);
+        caesar.zpracuj(&a[od], &a[od], n);
+        vigener.zpracuj(&b[od], &b[od], n);
+        xor_kontext.zpracuj(&c[od], &c[od], n);
+    }
+    EXPECT_EQ(a, caesar_sifra(text, 3, true));
+    EXPECT_EQ(b, vigener_sifra(text, klic, true));
+    EXPECT_EQ(c, xor_sifra(text, "heslo", true));
+}
+
+TEST(SifrovaciAlgoritmyTest, SifrujSoubor)
+{
+    std::string text = nahodny_text(10000, 5);
+    uloz_do_souboru("test_vstup.bin", text);
+
+    VigenerKontext sifrovani("tajny_klic", true);
+    ASSERT_TRUE(sifruj_soubor("test_vstup.bin", "test_sifra.bin", sifrovani, 777));
+    EXPECT_EQ(otevri_soubor("test_sifra.bin"), vigener_sifra(text, "tajny_klic", true));
+
+    VigenerKontext desifrovani("tajny_klic", false);
+    ASSERT_TRUE(sifruj_soubor("test_sifra.bin", "test_zpet.bin", desifrovani, 1000));
+    EXPECT_EQ(otevri_soubor("test_zpet.bin"), text);
+
+    XorKontext xor_kontext("heslo");
+    EXPECT_FALSE(sifruj_soubor("neexistujici_soubor.txt", "test_zpet.bin", xor_kontext));
+
+    // Přepsání delšího souboru kratším výstupem nenechá na konci zbytek
+    uloz_do_souboru("test_zpet.bin", text.substr(0, 100));
+    EXPECT_EQ(otevri_soubor("test_zpet.bin"), text.substr(0, 100));
+
+    // Výstup do vstupního souboru se odmítne a vstup zůstane celý
+    EXPECT_FALSE(sifruj_soubor("test_vstup.bin", "test_vstup.bin", xor_kontext));
+    EXPECT_EQ(otevri_soubor("test_vstup.bin"), text);
+
+    remove("test_vstup.bin");
+    remove("test_sifra.bin");
+    remove("test_zpet.bin");
+}
+
+TEST(SifrovaciAlgoritmyTest, SouboryBezMapovani)
+{
+    // Prázdný soubor nejde namapovat, musí se přečíst i zapsat přes proud
+    uloz_do_souboru("test_prazdny.txt", "");
+    EXPECT_TRUE(otevri_soubor("test_prazdny.txt").empty());
+    XorKontext xor_kontext("heslo");
+    EXPECT_TRUE(sifruj_soubor("test_prazdny.txt", "test_prazdny_sifra.txt", xor_kontext));
+    EXPECT_TRUE(otevri_soubor("test_prazdny_sifra.txt").empty());
+    remove("test_prazdny.txt");
+    remove("test_prazdny_sifra.txt");
+
+#ifdef __linux__
+    // Soubory v /proc hlásí nulovou velikost, obsah mají - čtou se přes proud
+    EXPECT_FALSE(otevri_soubor("/proc/self/status").empty());
+#endif
+}
+
+TEST(SifrovaciAlgoritmyTest, UlozDoSouboruPrepise)
+{
+    // Delší obsah a pak kratší - namapovaný výstup se musí zkrátit
+    uloz_do_souboru("test_prepis.txt", std::string(10000, 'x'));
+    uloz_do_souboru("test_prepis.txt", "kratky");
+    EXPECT_EQ(otevri_soubor("test_prepis.txt"), "kratky");
+    remove("test_prepis.txt");
+}
+
+TEST(SifrovaciAlgoritmyTest, SifrovaniDoBufferu)
+{
+    std::string text = nahodny_text(300, 9);
+
+    // Na místě
+    std::string buffer = text;
+    caesar_sifra(std::span<char>(buffer), 5, true);
+    EXPECT_EQ(buffer, caesar_sifra(text, 5, true));
+    caesar_sifra(std::span<char>(buffer), 5, false);
+    EXPECT_EQ(buffer, text);
+
+    vigener_sifra(std::span<char>(buffer), "tajny_klic", true);
+    EXPECT_EQ(buffer, vigener_sifra(text, "tajny_klic", true));
+    vigener_sifra(std::span<char>(buffer), "tajny_klic", false);
+    EXPECT_EQ(buffer, text);
+
+    xor_sifra(std::span<char>(buffer), "heslo", true);
+    EXPECT_EQ(buffer, xor_sifra(text, "heslo", true));
+
+    // Do předem připraveného (znovu použitého) bufferu
+    std::vector<char> vystup(text.size());
+    vigener_sifra(text, vystup, "klic", true);
+    EXPECT_EQ(std::string(vystup.begin(), vystup.end()), vigener_sifra(text, "klic", true));
+    xor_sifra(text, vystup, "heslo", true);
+    EXPECT_EQ(std::string(vystup.begin(), vystup.end()), xor_sifra(text, "heslo", true));
+
+    std::vector<char> maly(10);
+    EXPECT_THROW(caesar_sifra(text, maly, 3, true), std::invalid_argument);
+
+    // Klíče na zásobníku i na haldě (delší než KRATKY_KLIC) dávají totéž co kontext
+    for (size_t delka : {size_t(0), size_t(1), KRATKY_KLIC, KRATKY_KLIC + 1})
+    {
+        std::string klic = nahodny_text(delka, 10 + static_cast<unsigned int>(delka));
+        std::string ocekavano(text.size(), '\0');
+        VigenerKontext(klic, true).zpracuj(text.data(), &ocekavano[0], text.size());
+        vigener_sifra(text, vystup, klic, true);
+        EXPECT_EQ(std::string(vystup.begin(), vystup.end()), ocekavano);
+
+        XorKontext(klic).zpracuj(text.data(), &ocekavano[0], text.size());
+        xor_sifra(text, vystup, klic, true);
+        EXPECT_EQ(std::string(vystup.begin(), vystup.end()), ocekavano);
+    }
+}
+
+TEST(SifrovaciAlgoritmyTest, ParalelniSifrovani)
+{
+    std::string text = nahodny_text(1000003, 11);
+    EXPECT_EQ(caesar_sifra_paralelne(text, 7, true, 4), caesar_sifra(text, 7, true));
+    EXPECT_EQ(vigener_sifra_paralelne(text, "tajny_klic", true, 4), vigener_sifra(text, "tajny_klic", true));
+    EXPECT_EQ(vigener_sifra_paralelne(text, "tajny_klic", false, 3), vigener_sifra(text, "tajny_klic", false));
+    EXPECT_EQ(xor_sifra_paralelne(text, "heslo", 4), xor_sifra(text, "heslo", true));
+
+    // Stav po paralelním bloku musí navázat stejně jako po sériovém
+    VigenerKontext paralelni("klic", true);
+    XorKontext xor_paralelni("heslo");
+    std::string a = text, b = text;
+    paralelni.zpracuj_paralelne(&a[0], &a[0], 500001, 4);
+    paralelni.zpracuj(&a[500001], &a[500001], text.size() - 500001);
+    xor_paralelni.zpracuj_paralelne(&b[0], &b[0], 500001, 4);
+    xor_paralelni.zpracuj(&b[500001], &b[500001], text.size() - 500001);
+    EXPECT_EQ(a, vigener_sifra(text, "klic", true));
+    EXPECT_EQ(b, xor_sifra(text, "heslo", true));
+
+    uloz_do_souboru("test_paralelni.bin", text);
+    VigenerKontext soubor("tajny_klic", true);
+    ASSERT_TRUE(sifruj_soubor("test_paralelni.bin", "test_paralelni_sifra.bin", soubor, 1 << 20, 4));
+    EXPECT_EQ(otevri_soubor("test_paralelni_sifra.bin"), vigener_sifra(text, "tajny_klic", true));
+    remove("test_paralelni.bin");
+    remove("test_paralelni_sifra.bin");
+}
+
+TEST(SifrovaciAlgoritmyTest, XorJadraAPocatecniPozice)
+{
+    std::string text = nahodny_text(1000, 13);
+    std::vector<XorJadro> jadra = {xor_skalar};
+#ifdef SIFRY_X86_SIMD
+    jadra.push_back(xor_sse2);
+    if (__builtin_cpu_supports("avx2"))
+    {
+        jadra.push_back(xor_avx2);
+    }
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        jadra.push_back(xor_avx512);
+    }
+#endif
+    // Klíče kratší i delší než šířka vektoru, různé délky dat a počáteční pozice
+    for (const std::string &klic : std::vector<std::string>{"h", "heslo", "0123456789abcdefghijklmnopqrstuvwxyz", std::string(100, 'k') + "x"})
+    {
+        std::vector<unsigned char> bajty = rozvin_heslo(klic);
+        XorVzor vzor = {bajty.data(), klic.size()};
+        for (size_t n : {0, 7, 64, 129, 1000})
+        {
+            for (size_t pocatek : {size_t(0), klic.size() - 1})
+            {
+                std::string ocekavano(n, '\0');
+                for (size_t i = 0; i < n; i++)
+                {
+                    ocekavano[i] = static_cast<char>(text[i] ^ klic[(pocatek + i) % klic.size()]);
+                }
+                for (XorJadro jadro : jadra)
+                {
+                    std::string vystup(n, '\0');
+                    EXPECT_EQ(jadro(text.data(), &vystup[0], n, vzor, pocatek), (pocatek + n) % klic.size());
+                    EXPECT_EQ(vystup, ocekavano) << "klic = " << klic << ", n = " << n;
+                }
+            }
+        }
+    }
+
+    // Kontext s počáteční pozicí navazuje na předchozí část dat
+    std::string cela = xor_sifra(text, "heslo", true);
+    std::string druha_pulka = text.substr(501);
+    XorKontext(std::string("heslo"), 501).zpracuj(druha_pulka.data(), &druha_pulka[0], druha_pulka.size());
+    EXPECT_EQ(druha_pulka, cela.substr(501));
+}
+
+TEST(SifrovaciAlgoritmyTest, SifrovaciRetezec)
+{
+    std::string text = nahodny_text(100000, 21);
+
+    SifrovaciRetezec retezec;
+    retezec.pridej(std::make_unique<VigenerKontext>("tajny_klic", true))
+        .pridej(std::make_unique<XorKontext>("heslo"))
+        .pridej(std::make_unique<CaesarKontext>(7, true));
+    EXPECT_EQ(retezec.pocet_sifer(), 3u);
+    std::string ocekavano = caesar_sifra(xor_sifra(vigener_sifra(text, "tajny_klic", true), "heslo", true), 7, true);
+
+    // Jedním voláním i po nerovnoměrných blocích (stav se přenáší)
+    std::unique_ptr<SifrovaciKontext> kopie = SifrovaciRetezec().pridej(retezec.inverzni()).inverzni();
+    std::string vystup(text.size(), '\0');
+    retezec.zpracuj(text.data(), &vystup[0], 777);
+    retezec.zpracuj(text.data() + 777, &vystup[777], text.size() - 777);
+    EXPECT_EQ(vystup, ocekavano);
+
+    std::string na_miste = text;
+    kopie->zpracuj_paralelne(na_miste.data(), na_miste.data(), na_miste.size(), 4);
+    EXPECT_EQ(na_miste, ocekavano);
+
+    // Inverzní řetězec vrátí původní text
+    std::unique_ptr<SifrovaciKontext> zpet = retezec.inverzni();
+    zpet->zpracuj_paralelne(vystup.data(), vystup.data(), vystup.size(), 3);
+    EXPECT_EQ(vystup, text);
+
+    // Prázdný řetězec jen kopíruje
+    SifrovaciRetezec prazdny;
+    std::string kopie_textu(text.size(), '\0');
+    prazdny.zpracuj(text.data(), &kopie_textu[0], text.size());
+    EXPECT_EQ(kopie_textu, text);
+    EXPECT_THROW(prazdny.pridej(nullptr), std::invalid_argument);
+}
+
+TEST(SifrovaciAlgoritmyTest, InverzniXorSPocatecniPozici)
+{
+    std::string text = nahodny_text(50000, 22);
+
+    // Samotný kontext: inverze musí začít na stejné pozici v hesle
+    XorKontext xor_kontext("abc", 1);
+    std::string zasifrovano(text.size(), '\0');
+    xor_kontext.zpracuj(text.data(), &zasifrovano[0], text.size());
+    std::string zpet(text.size(), '\0');
+    xor_kontext.inverzni()->zpracuj(zasifrovano.data(), &zpet[0], zpet.size());
+    EXPECT_EQ(zpet, text);
+
+    // Řetězec s XOR, který nezačíná na začátku hesla
+    SifrovaciRetezec retezec;
+    retezec.pridej(std::make_unique<CaesarKontext>(5, true))
+        .pridej(std::make_unique<XorKontext>("heslo", 3))
+        .pridej(std::make_unique<VigenerKontext>("klic", true));
+    std::string vystup = text;
+    retezec.zpracuj_paralelne(vystup.data(), vystup.data(), vystup.size(), 4);
+    EXPECT_NE(vystup, text);
+    retezec.inverzni()->zpracuj(vystup.data(), vystup.data(), vystup.size());
+    EXPECT_EQ(vystup, text);
+}
+
+static const std::string CESKY_TEXT =
+    "Byl pozdni vecer, prvni maj, vecerni maj, byl lasky cas. Hrdliccin zval ku lasce hlas, kde borovy zavanel haj. "
+    "O lasce septime tichy mech, kvetouci strom lhal lasky zel, svou lasku slavik ruzi pel, ruzinu jevil vonny vzdech. "
+    "Jezero hladke v krovich stinnych zvucne temnel bol tajny, brehem je objimal kol, a slunce jasna cesta v nem. "
+    "Na ceske zemi zije mnoho lidi, kteri radi chodi do prirody a sbiraji houby v lesich. Vecer se vraceji domu, "
+    "vari polevku a vypraveji si o tom, co za den videli. Deti si hraji na zahrade a psi stekaji na kolemjdouci. "
+    "Ve meste jezdi tramvaje a autobusy, lide spechaji do prace a v poledne chodi na obed do jidelny nebo do restaurace. "
+    "Odpoledne se ucitele vraceji ze skoly, studenti pisou ukoly a programatori opravuji chyby ve svem kodu. "
+    "Kdyz prsi, sedi lide doma, ctou knihy, piji caj a divaji se z okna na mokrou ulici, po ktere tecou potoky vody.";
+
+TEST(KryptoanalyzaTest, HistogramPismen)
+{
+    std::string text = nahodny_text(10000, 5) + "Az";
+    std::array<uint64_t, 26> ocekavano = {};
+    for (char c : text)
+    {
+        if (std::isalpha(static_cast<unsigned char>(c)))
+        {
+            ocekavano[std::tolower(static_cast<unsigned char>(c)) - 'a']++;
+        }
+    }
+    EXPECT_EQ(histogram_pismen(text), ocekavano);
+    EXPECT_EQ(histogram_skalar(text.data(), text.size()), ocekavano);
+#ifdef KRYPTOANALYZA_X86_SIMD
+    if (__builtin_cpu_supports("avx2"))
+    {
+        EXPECT_EQ(histogram_avx2(text.data(), text.size()), ocekavano);
+    }
+#endif
+    EXPECT_EQ(histogram_pismen(std::string()), (std::array<uint64_t, 26>{}));
+}
+
+TEST(KryptoanalyzaTest, ProlomCaesar)
+{
+    for (int posun : {0, 3, 13, 25})
+    {
+        std::vector<KandidatCaesar> kandidati = prolom_caesar(caesar_sifra(CESKY_TEXT, posun, true));
+        ASSERT_EQ(kandidati.size(), 26u);
+        EXPECT_EQ(kandidati[0].posun, posun);
+        EXPECT_LE(kandidati[0].skore, kandidati[1].skore);
+    }
+    // Vzorek z krátkého začátku textu stačí
+    EXPECT_EQ(prolom_caesar(caesar_sifra(CESKY_TEXT, 7, true), CESTINA, 400)[0].posun, 7);
+}
+
+TEST(KryptoanalyzaTest, ProlomVigener)
+{
+    std::string text = CESKY_TEXT + CESKY_TEXT;
+    for (const std::string klic : {"tajnyklic", "heslo", "x"})
+    {
+        std::string sifra = vigener_sifra(text, klic, true);
+        std::vector<KandidatVigener> kandidati = prolom_vigener(sifra, 20, 3, 4);
+        ASSERT_FALSE(kandidati.empty());
+        EXPECT_EQ(kandidati[0].klic, klic);
+        EXPECT_EQ(vigener_sifra(sifra, kandidati[0].klic, false), text);
+        for (size_t i = 1; i < kandidati.size(); i++)
+        {
+            EXPECT_LE(kandidati[i - 1].skore, kandidati[i].skore);
+            EXPECT_NE(kandidati[i].klic, kandidati[0].klic);
+        }
+    }
+    EXPECT_TRUE(prolom_vigener(std::string("123 !?")).empty());
+    EXPECT_EQ(nejkratsi_perioda("abcabcabc"), "abc");
+    EXPECT_EQ(nejkratsi_perioda("abcab"), "abcab");
+}
+
+TEST(SifrovaciAlgoritmyTest, PevneKlice)
+{
+    // Tabulky se počítají při překladu
+    static_assert(CaesarPevny<3>::tabulka['a'] == 'd');
+    static_assert(CaesarPevny<3, false>::tabulka['A'] == 'X');
+    static_assert(CaesarPevny<3>::tabulka['!'] == '!');
+    static_assert(VigenerPevny<"B">::posuny[0] == 1 && VigenerPevny<"b", false>::posuny[0] == 25);
+    static_assert(XorPevny<"ab">::bajty[2] == 'a');
+
+    std::string vsechny_bajty;
+    for (int b = 0; b < 256; b++)
+    {
+        vsechny_bajty.push_back(static_cast<char>(b));
+    }
+    for (int posun : {3, -3, -27, -1000000})
+    {
+        std::array<char, 256> tabulka = caesar_tabulka(posun);
+        EXPECT_EQ(std::string(tabulka.begin(), tabulka.end()), caesar_puvodni(vsechny_bajty, posun, true)) << "posun = " << posun;
+    }
+
+    std::string text = nahodny_text(3000, 17);
+    std::string klic = "PevnyKlic";
+    std::string caesar_pred = caesar_sifra(text, -1000000, true);
+    std::string vigener_pred = vigener_sifra(text, klic, true);
+    std::string xor_pred = xor_sifra(text, "heslo", true);
+    EXPECT_FALSE(najdi_vigener(klic, true).has_value());
+
+    registruj_caesar<-1000000>();
+    registruj_vigener<"PevnyKlic">();
+    registruj_xor<"heslo">();
+    EXPECT_EQ(najdi_caesar(-1000000), CaesarPevny<-1000000>::tabulka.data());
+    EXPECT_EQ(najdi_caesar(1000000), (CaesarPevny<-1000000, false>::tabulka.data()));
+    ASSERT_TRUE(najdi_vigener(klic, false).has_value());
+    EXPECT_EQ(najdi_vigener(klic, false)->posuny, (VigenerPevny<"PevnyKlic", false>::posuny.data()));
+    ASSERT_TRUE(najdi_xor("heslo").has_value());
+    EXPECT_EQ(najdi_xor("heslo")->bajty, XorPevny<"heslo">::bajty.data());
+
+    // Opakovaná registrace nevytvoří nový snímek registru
+    size_t snimku = registr().snimky.size();
+    registruj_xor<"heslo">();
+    registruj_vigener<"PevnyKlic">();
+    EXPECT_EQ(registr().snimky.size(), snimku);
+
+    // Registrované klíče dávají stejný výsledek jako výpočet za běhu
+    EXPECT_EQ(caesar_sifra(text, -1000000, true), caesar_pred);
+    EXPECT_EQ(caesar_sifra(caesar_pred, -1000000, false), caesar_puvodni(caesar_pred, -1000000, false));
+    EXPECT_EQ(vigener_sifra(text, klic, true), vigener_pred);
+    EXPECT_EQ(vigener_sifra(vigener_pred, klic, false), vigener_puvodni(vigener_pred, klic, false));
+    EXPECT_EQ(xor_sifra(text, "heslo", true), xor_pred);
+    EXPECT_EQ(xor_sifra_paralelne(text, "heslo", 4), xor_pred);
+}
+
+TEST(SifrovaciAlgoritmyTest, DavkoveSifrovani)
+{
+    namespace fs = std::filesystem;
+    // Relativně jako ostatní testy, s PID procesu, aby se souběžné běhy nepletly
+    fs::path koren = "test_davka_" + std::to_string(getpid());
+    fs::remove_all(koren);
+    bool io_uring_k_dispozici = false;
+#ifdef SIFRY_IO_URING
+    io_uring_k_dispozici = IoUring(8).funguje();
+#endif
+    fs::create_directories(koren / "vstup" / "podadresar");
+
+    std::map<std::string, std::string> obsahy = {
+        {"prazdny.txt", ""},
+        {"maly.txt", "Toto je tajna zprava!"},
+        {"stredni.txt", nahodny_text(100000, 1)},
+        {"podadresar/velky.txt", nahodny_text(3000000, 2)},
+    };
+    for (const auto &[jmeno, obsah] : obsahy)
+    {
+        uloz_do_souboru((koren / "vstup" / jmeno).string(), obsah);
+    }
+
+    std::vector<UlohaSouboru> ulohy = ulohy_z_adresare((koren / "vstup").string(), (koren / "vystup").string());
+    ASSERT_EQ(ulohy.size(), obsahy.size());
+    EXPECT_EQ(ulohy[0].second, (koren / "vystup" / "maly.txt").string());
+
+    TovarnaKontextu tovarna = []() { return std::make_unique<VigenerKontext>("tajny_klic", true); };
+    // io_uring i fond vláken; malé bloky a malý limit paměti, aby se soubory dělily a čekalo se na paměť
+    for (bool io_uring : {true, false})
+    {
+        NastaveniDavky nastaveni;
+        nastaveni.io_uring = io_uring;
+        nastaveni.velikost_bloku = 64 * 1024;
+        nastaveni.max_v_letu = 3 * 64 * 1024;
+        nastaveni.vlakna = 2;
+        fs::remove_all(koren / "vystup");
+
+        SouhrnDavky souhrn = sifruj_davku(ulohy, tovarna, nastaveni);
+        EXPECT_EQ(souhrn.chyb, 0u);
+        EXPECT_EQ(souhrn.io_uring, io_uring && io_uring_k_dispozici);
+        size_t bajtu = 0;
+        for (const auto &[jmeno, obsah] : obsahy)
+        {
+            EXPECT_EQ(otevri_soubor((koren / "vystup" / jmeno).string()), vigener_sifra(obsah, "tajny_klic", true))
+                << jmeno << ", io_uring = " << souhrn.io_uring;
+            bajtu += obsah.size();
+        }
+        EXPECT_EQ(souhrn.bajtu, bajtu);
+
+        std::ostringstream vypis;
+        vypis_souhrn(vypis, souhrn);
+        EXPECT_NE(vypis.str().find("Celkem: 4 souboru (0 chyb)"), std::string::npos);
+    }
+
+    // Seznam souborů s neexistujícím souborem
+    uloz_do_souboru((koren / "seznam.txt").string(),
+                    (koren / "vstup" / "maly.txt").string() + "\n\n" + (koren / "neexistujici.txt").string() + "\n");
+    ulohy = ulohy_ze_seznamu((koren / "seznam.txt").string(), (koren / "ze_seznamu").string());
+    ASSERT_EQ(ulohy.size(), 2u);
+    for (bool io_uring : {true, false})
+    {
+        NastaveniDavky nastaveni;
+        nastaveni.io_uring = io_uring;
+        SouhrnDavky souhrn = sifruj_davku(ulohy, tovarna, nastaveni);
+        EXPECT_EQ(souhrn.chyb, 1u);
+        EXPECT_EQ(souhrn.io_uring, io_uring && io_uring_k_dispozici);
+        EXPECT_TRUE(souhrn.soubory[0].uspech);
+        EXPECT_FALSE(souhrn.soubory[1].uspech);
+        EXPECT_EQ(otevri_soubor((koren / "ze_seznamu" / "maly.txt").string()), vigener_sifra("Toto je tajna zprava!", "tajny_klic", true));
+    }
+
+    // Stejně pojmenované soubory z různých adresářů: zpracuje se jen první, druhý je chyba
+    fs::create_directories(koren / "x");
+    fs::create_directories(koren / "y");
+    uloz_do_souboru((koren / "x" / "f.txt").string(), "prvni soubor");
+    uloz_do_souboru((koren / "y" / "f.txt").string(), "druhy soubor");
+    uloz_do_souboru((koren / "seznam.txt").string(),
+                    (koren / "x" / "f.txt").string() + "\n" + (koren / "y" / "f.txt").string() + "\n");
+    ulohy = ulohy_ze_seznamu((koren / "seznam.txt").string(), (koren / "stejna_jmena").string());
+    ASSERT_EQ(ulohy.size(), 2u);
+    for (bool io_uring : {true, false})
+    {
+        NastaveniDavky nastaveni;
+        nastaveni.io_uring = io_uring;
+        fs::remove_all(koren / "stejna_jmena");
+        SouhrnDavky souhrn = sifruj_davku(ulohy, tovarna, nastaveni);
+        EXPECT_EQ(souhrn.chyb, 1u);
+        EXPECT_TRUE(souhrn.soubory[0].uspech);
+        EXPECT_FALSE(souhrn.soubory[1].uspech);
+        EXPECT_EQ(otevri_soubor((koren / "stejna_jmena" / "f.txt").string()), vigener_sifra("prvni soubor", "tajny_klic", true));
+    }
+
+    // Výstupní adresář je vstupní: každý soubor je chyba a vstupy zůstanou beze změny
+    ulohy = ulohy_z_adresare((koren / "vstup").string(), (koren / "vstup").string());
+    for (bool io_uring : {true, false})
+    {
+        NastaveniDavky nastaveni;
+        nastaveni.io_uring = io_uring;
+        SouhrnDavky souhrn = sifruj_davku(ulohy, tovarna, nastaveni);
+        EXPECT_EQ(souhrn.chyb, obsahy.size());
+        for (const auto &[jmeno, obsah] : obsahy)
+        {
+            EXPECT_EQ(otevri_soubor((koren / "vstup" / jmeno).string()), obsah) << jmeno << ", io_uring = " << io_uring;
+        }
+    }
+    fs::remove_all(koren);
+}
@@ -1,6 +1,17 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include <string>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 /**
  * Struktura pro uzel jednoduše vázaného seznamu (linked list).
  */
@@ -207,34 +218,202 @@ int findFirstOccurrence(Node *head, int value)
 }
 
 /**
- * Setřídí seznam podle hodnot prvků (vzestupně).
+ * Setříděný řetězec uzlů i s posledním uzlem (konec se tak nemusí hledat průchodem).
+ */
+struct Run
+{
+    Node *head;
+    Node *tail;
+};
+
+/**
+ * Slije dva setříděné řetězce do jednoho přepojením ukazatelů next (bez alokace).
+ * Při shodě jde první prvek z left, slévání je tedy stabilní.
+ */
+static Run mergeRuns(Run left, Run right)
+{
+    if (left.head == nullptr)
+    {
+        return right;
+    }
+    if (right.head == nullptr)
+    {
+        return left;
+    }
+    Node dummy{0, nullptr};
+    Node *last = &dummy;
+    Node *l = left.head;
+    Node *r = right.head;
+    while (l != nullptr && r != nullptr)
+    {
+        if (r->data < l->data)
+        {
+            last->next = r;
+            r = r->next;
+        }
+        else
+        {
+            last->next = l;
+            l = l->next;
+        }
+        last = last->next;
+    }
+    // Zbytek jednoho z řetězců se připojí celý, jeho konec je konec výsledku
+    if (l != nullptr)
+    {
+        last->next = l;
+        return {dummy.next, left.tail};
+    }
+    last->next = r;
+    return {dummy.next, r != nullptr ? right.tail : last};
+}
+
+/**
+ * Odpojí ze začátku *rest nejdelší již setříděný úsek (běh) a vrátí ho.
+ * Ostře klesající úsek se otočí (stabilitu to neporuší, shodné prvky v něm nejsou).
+ */
+static Run takeRun(Node **rest)
+{
+    Node *first = *rest;
+    Node *last = first;
+    if (last->next != nullptr && last->next->data < last->data)
+    {
+        // Klesající běh: otáčíme ho za běhu
+        Node *reversed = first;
+        Node *node = first->next;
+        first->next = nullptr;
+        while (node != nullptr && node->data < reversed->data)
+        {
+            Node *next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        *rest = node;
+        return {reversed, first};
+    }
+    while (last->next != nullptr && !(last->next->data < last->data))
+    {
+        last = last->next;
+    }
+    *rest = last->next;
+    last->next = nullptr;
+    return {first, last};
+}
+
+/**
+ * Přirozený merge sort zdola nahoru: seznam se rozdělí na již setříděné běhy
+ * a ty se slévají jako u binárního čítače (bucket[i] obsahuje slití 2^i běhů),
+ * takže stačí pevné pole na zásobníku. Skoro setříděný seznam má málo běhů
+ * a třídí se skoro v O(n), obecně v O(n log n).
+ */
+static Run mergeSort(Node *head)
+{
+    // 64 bucketů stačí na 2^64 běhů
+    Run buckets[64] = {};
+    Node *rest = head;
+    while (rest != nullptr)
+    {
+        Run run = takeRun(&rest);
+        int i = 0;
+        for (; buckets[i].head != nullptr; i++)
+        {
+            // Starší běh (z bucketu) jde vlevo kvůli stabilitě
+            run = mergeRuns(buckets[i], run);
+            buckets[i] = Run{nullptr, nullptr};
+        }
+        buckets[i] = run;
+    }
+
+    Run result = {nullptr, nullptr};
+    for (const Run &bucket : buckets)
+    {
+        result = mergeRuns(bucket, result);
+    }
+    return result;
+}
+
+/**
+ * Setřídí seznam podle hodnot prvků (vzestupně). Uzly se přepojují (data se
+ * nekopírují), třídění je stabilní a nic nealokuje.
  * @param head Ukazatel na ukazatel na první uzel seznamu.
  */
 void sortList(Node **head)
 {
-    if (*head == nullptr || (*head)->next == nullptr)
+    *head = mergeSort(*head).head;
+}
+
+/**
+ * Paralelní třídění: seznam se rozdělí na úseky, každý se setřídí ve vlastním
+ * vlákně a úseky se pak popořadě slijí (stabilně). Krátké seznamy se třídí
+ * v jednom vlákně, vlákna by se nevyplatila.
+ * @param head První uzel seznamu.
+ * @param threads Počet vláken (0 = podle počtu jader).
+ */
+static Run mergeSortParallel(Node *head, unsigned int threads)
+{
+    const size_t MIN_NODES_PER_THREAD = 1 << 16;
+    size_t count = 0;
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        count++;
+    }
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned int>(std::min<size_t>(threads, count / MIN_NODES_PER_THREAD));
+    if (threads <= 1)
     {
-        return; // seznam je prázdný nebo obsahuje 1 prvek
+        return mergeSort(head);
     }
 
-    // Bubble sort
-    bool swapped;
-    do
+    // Rozdělení na threads úseků o skoro stejné délce
+    std::vector<Run> parts(threads);
+    Node *node = head;
+    for (unsigned int i = 0; i < threads; i++)
     {
-        swapped = false;
-        Node *ptr = *head;
-        while (ptr->next != nullptr)
+        parts[i].head = node;
+        size_t length = count / threads + (i < count % threads ? 1 : 0);
+        for (size_t j = 1; j < length; j++)
         {
-            if (ptr->data > ptr->next->data)
-            {
-                int temp = ptr->data;
-                ptr->data = ptr->next->data;
-                ptr->next->data = temp;
-                swapped = true;
-            }
-            ptr = ptr->next;
+            node = node->next;
+        }
+        Node *next = node->next;
+        node->next = nullptr;
+        node = next;
+    }
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < threads; i++)
+    {
+        workers.emplace_back([&parts, i]() { parts[i] = mergeSort(parts[i].head); });
+    }
+    parts[0] = mergeSort(parts[0].head);
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Slévání sousedních úseků po dvojicích (úsek vlevo má přednost)
+    for (unsigned int step = 1; step < threads; step *= 2)
+    {
+        for (unsigned int i = 0; i + step < threads; i += 2 * step)
+        {
+            parts[i] = mergeRuns(parts[i], parts[i + step]);
         }
-    } while (swapped);
+    }
+    return parts[0];
+}
+
+/**
+ * Setřídí seznam stabilně ve více vláknech.
+ * @param head Ukazatel na ukazatel na první uzel seznamu.
+ * @param threads Počet vláken (0 = podle počtu jader).
+ */
+void sortListParallel(Node **head, unsigned int threads = 0)
+{
+    *head = mergeSortParallel(*head, threads).head;
 }
 
 /**
@@ -273,32 +452,1157 @@ std::ostream &operator<<(std::ostream &os, Node *head)
     return os;
 }
 
-#ifndef __TEST__
-int main()
+/**
+ * Alokátor uzlů po velkých blocích (slabech). Uzly jednoho slabu leží v paměti
+ * za sebou (slab je zarovnaný na cache line, do 64 B se vejdou 4 uzly), takže
+ * průchod seznamem vytvořeným postupným vkládáním čte paměť sekvenčně.
+ * Uvolněné uzly se řadí do seznamu volných uzlů a znovu se použijí.
+ * Místo new/delete pro každý uzel je tak jedna alokace na NODES_PER_SLAB uzlů.
+ */
+class NodePool
+{
+public:
+    static const size_t NODES_PER_SLAB = 4096;
+    static const size_t CACHE_LINE = 64;
+
+    NodePool() = default;
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    ~NodePool()
+    {
+        releaseAll();
+    }
+
+    /**
+     * Vrátí nový uzel s hodnotou data (next = nullptr).
+     */
+    Node *allocate(int data)
+    {
+        Node *node = m_freeList;
+        if (node != nullptr)
+        {
+            m_freeList = node->next;
+        }
+        else
+        {
+            if (m_usedInLastSlab == NODES_PER_SLAB)
+            {
+                void *slab = ::operator new(NODES_PER_SLAB * sizeof(Node), std::align_val_t(CACHE_LINE));
+                m_slabs.push_back(static_cast<Node *>(slab));
+                m_usedInLastSlab = 0;
+            }
+            node = m_slabs.back() + m_usedInLastSlab++;
+        }
+        return new (node) Node{data, nullptr};
+    }
+
+    /**
+     * Vrátí uzel do poolu.
+     */
+    void release(Node *node)
+    {
+        node->next = m_freeList;
+        m_freeList = node;
+    }
+
+    /**
+     * Vrátí do poolu celý řetězec first..last v O(1) (last->next se přepíše).
+     */
+    void releaseChain(Node *first, Node *last)
+    {
+        if (first == nullptr)
+        {
+            return;
+        }
+        last->next = m_freeList;
+        m_freeList = first;
+    }
+
+    /**
+     * Uvolní všechny slaby najednou v O(počtu slabů). Všechny uzly z poolu
+     * (i ty v seznamech) tím přestanou platit, seznamy je potřeba vyprázdnit.
+     */
+    void releaseAll()
+    {
+        for (Node *slab : m_slabs)
+        {
+            ::operator delete(slab, std::align_val_t(CACHE_LINE));
+        }
+        m_slabs.clear();
+        m_freeList = nullptr;
+        m_usedInLastSlab = NODES_PER_SLAB;
+    }
+
+    size_t slabCount() const
+    {
+        return m_slabs.size();
+    }
+
+private:
+    std::vector<Node *> m_slabs;
+    Node *m_freeList = nullptr;
+    size_t m_usedInLastSlab = NODES_PER_SLAB;
+};
+
+/**
+ * Seznam s ukazatelem na poslední uzel a počtem prvků. Díky tomu je vložení
+ * na konec a zjištění délky O(1) (funkce nad Node** musí projít celý seznam).
+ * Pro práci se seznamem používejte jen funkce, které berou LinkedList*,
+ * jinak by tail a size přestaly odpovídat.
+ */
+struct LinkedList
 {
-    // Vytvoření seznamu
     Node *head = nullptr;
-    insertAtBeginning(&head, 1);
-    insertAtBeginning(&head, 2);
-    insertAtEnd(&head, 3);
-    insertAtEnd(&head, 4);
-    insertAtIndex(&head, 5, 2);
+    Node *tail = nullptr;
+    size_t size = 0;
+    NodePool *pool = nullptr; // nullptr = uzly přes new/delete jako createNode
+};
 
-    std::cout << "Seznam po vložení prvků: " << head << std::endl;
-    std::cout << "První výskyt hodnoty 3 je na indexu: " << findFirstOccurrence(head, 3) << std::endl;
+// Alokace a uvolnění uzlu seznamu přes jeho pool (pokud nějaký má)
+static Node *allocateNode(LinkedList *list, int data)
+{
+    return list->pool != nullptr ? list->pool->allocate(data) : createNode(data);
+}
 
-    std::cout << "Seznam před tříděním: " << head << std::endl;
-    sortList(&head);
-    std::cout << "Seznam po třídění: " << head << std::endl;
+static void freeNode(LinkedList *list, Node *node)
+{
+    if (list->pool != nullptr)
+    {
+        list->pool->release(node);
+    }
+    else
+    {
+        delete node;
+    }
+}
 
-    deleteAtBeginning(&head);
-    deleteAtEnd(&head);
-    std::cout << "Seznam po smazání prvků: " << head << std::endl;
+/**
+ * Vloží nový uzel s hodnotou data na začátek seznamu.
+ * @param list Seznam
+ * @param data Hodnota, která se vloží do nového uzlu.
+ */
+void insertAtBeginning(LinkedList *list, int data)
+{
+    Node *newNode = allocateNode(list, data);
+    newNode->next = list->head;
+    list->head = newNode;
+    if (list->tail == nullptr)
+    {
+        list->tail = list->head;
+    }
+    list->size++;
+}
 
-    deleteAtIndex(head, 1);
-    std::cout << "Seznam po smazání prvků: " << head << std::endl;
+/**
+ * Vloží nový uzel s hodnotou data na konec seznamu v O(1).
+ * @param list Seznam
+ * @param data Hodnota, která se vloží do nového uzlu.
+ */
+void insertAtEnd(LinkedList *list, const int data)
+{
+    Node *newNode = allocateNode(list, data);
+    if (list->tail == nullptr)
+    {
+        list->head = newNode;
+    }
+    else
+    {
+        list->tail->next = newNode;
+    }
+    list->tail = newNode;
+    list->size++;
+}
 
-    deleteList(&head);
+/**
+ * Vloží nový uzel na zadaný index (stejná pravidla jako insertAtIndex nad Node**).
+ * Index za koncem seznamu znamená vložení na konec, to je O(1).
+ * @param list Seznam
+ * @param data Hodnota, která se vloží do nového uzlu.
+ * @param index Pozice, kam se má uzel vložit.
+ */
+void insertAtIndex(LinkedList *list, int data, int index)
+{
+    if (index <= 0)
+    {
+        insertAtBeginning(list, data);
+        return;
+    }
+    if (static_cast<size_t>(index) >= list->size)
+    {
+        insertAtEnd(list, data);
+        return;
+    }
+
+    // Najdeme uzel na pozici index - 1 (existuje, index < size)
+    Node *temp = list->head;
+    for (int i = 0; i < index - 1; i++)
+    {
+        temp = temp->next;
+    }
+    Node *newNode = allocateNode(list, data);
+    newNode->next = temp->next;
+    temp->next = newNode;
+    list->size++;
+}
+
+/**
+ * Smaže uzel ze začátku seznamu (pokud existuje).
+ * @param list Seznam
+ */
+void deleteAtBeginning(LinkedList *list)
+{
+    if (list->head == nullptr)
+    {
+        return; // seznam je prázdný
+    }
+    Node *temp = list->head;
+    list->head = temp->next;
+    freeNode(list, temp);
+    if (list->head == nullptr)
+    {
+        list->tail = nullptr;
+    }
+    list->size--;
+}
+
+/**
+ * Smaže uzel z konce seznamu (pokud existuje).
+ * POZN: V jednoduše vázaném seznamu je potřeba najít předposlední uzel,
+ * takže to zůstává O(n).
+ * @param list Seznam
+ */
+void deleteAtEnd(LinkedList *list)
+{
+    if (list->head == nullptr)
+    {
+        return; // seznam je prázdný
+    }
+    if (list->head == list->tail)
+    {
+        freeNode(list, list->head);
+        list->head = list->tail = nullptr;
+        list->size = 0;
+        return;
+    }
+
+    // Najdeme předposlední uzel
+    Node *temp = list->head;
+    while (temp->next != list->tail)
+    {
+        temp = temp->next;
+    }
+    freeNode(list, list->tail);
+    temp->next = nullptr;
+    list->tail = temp;
+    list->size--;
+}
+
+/**
+ * Smaže uzel na zadaném indexu (pokud existuje). Na rozdíl od verze s Node*
+ * umí smazat i první uzel (index 0).
+ * @param list Seznam
+ * @param index Index uzlu, který se má smazat (0 = první uzel).
+ */
+void deleteAtIndex(LinkedList *list, int index)
+{
+    if (index < 0 || static_cast<size_t>(index) >= list->size)
+    {
+        return; // index mimo rozsah seznamu
+    }
+    if (index == 0)
+    {
+        deleteAtBeginning(list);
+        return;
+    }
+
+    // Najdeme uzel před vybraným indexem
+    Node *temp = list->head;
+    for (int i = 0; i < index - 1; i++)
+    {
+        temp = temp->next;
+    }
+    Node *nodeToDelete = temp->next;
+    temp->next = nodeToDelete->next;
+    if (nodeToDelete == list->tail)
+    {
+        list->tail = temp;
+    }
+    freeNode(list, nodeToDelete);
+    list->size--;
+}
+
+/**
+ * Najde první výskyt hodnoty value v seznamu a vrátí jeho index (0-based), jinak -1.
+ */
+int findFirstOccurrence(const LinkedList *list, int value)
+{
+    return findFirstOccurrence(list->head, value);
+}
+
+/**
+ * Setřídí seznam vzestupně a aktualizuje ukazatel na poslední uzel.
+ * @param list Seznam
+ */
+void sortList(LinkedList *list)
+{
+    Run sorted = mergeSort(list->head);
+    list->head = sorted.head;
+    list->tail = sorted.tail;
+}
+
+/**
+ * Setřídí seznam stabilně ve více vláknech (0 = podle počtu jader).
+ */
+void sortListParallel(LinkedList *list, unsigned int threads = 0)
+{
+    Run sorted = mergeSortParallel(list->head, threads);
+    list->head = sorted.head;
+    list->tail = sorted.tail;
+}
+
+/**
+ * Smaže (dealokuje) celý seznam a nechá ho prázdný. Se zadaným poolem se
+ * celý řetězec vrátí do poolu v O(1).
+ * @param list Seznam
+ */
+void deleteList(LinkedList *list)
+{
+    if (list->pool != nullptr)
+    {
+        list->pool->releaseChain(list->head, list->tail);
+        list->head = nullptr;
+    }
+    deleteList(&list->head);
+    list->tail = nullptr;
+    list->size = 0;
+}
+
+/**
+ * Uvolní najednou celý pool seznamu (NodePool::releaseAll) a nechá seznam
+ * prázdný. Ostatní seznamy nad stejným poolem tím přestanou platit. Seznam bez
+ * poolu se jen smaže jako v deleteList.
+ * @param list Seznam
+ */
+void releasePool(LinkedList *list)
+{
+    if (list->pool == nullptr)
+    {
+        deleteList(list);
+        return;
+    }
+    list->pool->releaseAll();
+    list->head = list->tail = nullptr;
+    list->size = 0;
+}
+
+/**
+ * Tisk seznamu stejně jako u Node* ("data data data").
+ */
+std::ostream &operator<<(std::ostream &os, const LinkedList &list)
+{
+    return os << list.head;
+}
+
+/**
+ * Uzel s 32bitovým indexem dalšího uzlu místo 64bitového ukazatele: 8 B místo 16 B,
+ * do cache line se tedy vejde dvakrát víc uzlů. Uzly leží v jednom poli poolu
+ * (IndexNodePool), indexy zůstávají platné i po jeho zvětšení.
+ */
+struct IndexNode
+{
+    int data;
+    uint32_t next;
+};
+
+const uint32_t NO_NODE = UINT32_MAX;
+
+class IndexNodePool
+{
+public:
+    uint32_t allocate(int data)
+    {
+        uint32_t index = m_freeList;
+        if (index != NO_NODE)
+        {
+            m_freeList = m_nodes[index].next;
+            m_nodes[index] = IndexNode{data, NO_NODE};
+            return index;
+        }
+        if (m_nodes.size() >= NO_NODE)
+        {
+            throw std::length_error("IndexNodePool: více uzlů, než lze adresovat 32 bity.");
+        }
+        m_nodes.push_back(IndexNode{data, NO_NODE});
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    void release(uint32_t index)
+    {
+        m_nodes[index].next = m_freeList;
+        m_freeList = index;
+    }
+
+    void releaseChain(uint32_t first, uint32_t last)
+    {
+        if (first == NO_NODE)
+        {
+            return;
+        }
+        m_nodes[last].next = m_freeList;
+        m_freeList = first;
+    }
+
+    /** Uvolní všechny uzly najednou (všechny seznamy nad poolem přestanou platit). */
+    void releaseAll()
+    {
+        m_nodes.clear();
+        m_nodes.shrink_to_fit();
+        m_freeList = NO_NODE;
+    }
+
+    IndexNode &operator[](uint32_t index)
+    {
+        return m_nodes[index];
+    }
+
+    const IndexNode &operator[](uint32_t index) const
+    {
+        return m_nodes[index];
+    }
+
+private:
+    std::vector<IndexNode> m_nodes;
+    uint32_t m_freeList = NO_NODE;
+};
+
+/**
+ * Seznam nad IndexNodePool (head, tail a size jako u LinkedList) se stejnými
+ * operacemi jako LinkedList. Víc seznamů může sdílet jeden pool. Uzly nemají
+ * jinde než v poolu kde ležet, pool je proto povinný argument konstruktoru.
+ */
+struct IndexLinkedList
+{
+    explicit IndexLinkedList(IndexNodePool *nodePool) : pool(nodePool) {}
+
+    IndexNodePool *pool = nullptr;
+    uint32_t head = NO_NODE;
+    uint32_t tail = NO_NODE;
+    size_t size = 0;
+};
+
+/**
+ * Vloží nový uzel s hodnotou data na začátek seznamu.
+ */
+void insertAtBeginning(IndexLinkedList *list, int data)
+{
+    uint32_t node = list->pool->allocate(data);
+    (*list->pool)[node].next = list->head;
+    list->head = node;
+    if (list->tail == NO_NODE)
+    {
+        list->tail = node;
+    }
+    list->size++;
+}
+
+/**
+ * Vloží nový uzel s hodnotou data na konec seznamu v O(1).
+ */
+void insertAtEnd(IndexLinkedList *list, int data)
+{
+    uint32_t node = list->pool->allocate(data);
+    if (list->tail == NO_NODE)
+    {
+        list->head = node;
+    }
+    else
+    {
+        (*list->pool)[list->tail].next = node;
+    }
+    list->tail = node;
+    list->size++;
+}
+
+/**
+ * Vloží nový uzel na zadaný index (stejná pravidla jako insertAtIndex nad LinkedList).
+ */
+void insertAtIndex(IndexLinkedList *list, int data, int index)
+{
+    if (index <= 0)
+    {
+        insertAtBeginning(list, data);
+        return;
+    }
+    if (static_cast<size_t>(index) >= list->size)
+    {
+        insertAtEnd(list, data);
+        return;
+    }
+
+    IndexNodePool &pool = *list->pool;
+    // Najdeme uzel na pozici index - 1 (existuje, index < size)
+    uint32_t temp = list->head;
+    for (int i = 0; i < index - 1; i++)
+    {
+        temp = pool[temp].next;
+    }
+    // allocate může zvětšit pole uzlů, reference do poolu proto bereme až po ní
+    uint32_t node = pool.allocate(data);
+    pool[node].next = pool[temp].next;
+    pool[temp].next = node;
+    list->size++;
+}
+
+/**
+ * Smaže uzel ze začátku seznamu (pokud existuje).
+ */
+void deleteAtBeginning(IndexLinkedList *list)
+{
+    if (list->head == NO_NODE)
+    {
+        return; // seznam je prázdný
+    }
+    uint32_t node = list->head;
+    list->head = (*list->pool)[node].next;
+    list->pool->release(node);
+    if (list->head == NO_NODE)
+    {
+        list->tail = NO_NODE;
+    }
+    list->size--;
+}
+
+/**
+ * Smaže uzel z konce seznamu (pokud existuje), O(n) jako u LinkedList.
+ */
+void deleteAtEnd(IndexLinkedList *list)
+{
+    if (list->head == NO_NODE)
+    {
+        return; // seznam je prázdný
+    }
+    if (list->head == list->tail)
+    {
+        list->pool->release(list->head);
+        list->head = list->tail = NO_NODE;
+        list->size = 0;
+        return;
+    }
+
+    // Najdeme předposlední uzel
+    IndexNodePool &pool = *list->pool;
+    uint32_t temp = list->head;
+    while (pool[temp].next != list->tail)
+    {
+        temp = pool[temp].next;
+    }
+    pool.release(list->tail);
+    pool[temp].next = NO_NODE;
+    list->tail = temp;
+    list->size--;
+}
+
+/**
+ * Smaže uzel na zadaném indexu (pokud existuje), index 0 = první uzel.
+ */
+void deleteAtIndex(IndexLinkedList *list, int index)
+{
+    if (index < 0 || static_cast<size_t>(index) >= list->size)
+    {
+        return; // index mimo rozsah seznamu
+    }
+    if (index == 0)
+    {
+        deleteAtBeginning(list);
+        return;
+    }
+
+    // Najdeme uzel před vybraným indexem
+    IndexNodePool &pool = *list->pool;
+    uint32_t temp = list->head;
+    for (int i = 0; i < index - 1; i++)
+    {
+        temp = pool[temp].next;
+    }
+    uint32_t nodeToDelete = pool[temp].next;
+    pool[temp].next = pool[nodeToDelete].next;
+    if (nodeToDelete == list->tail)
+    {
+        list->tail = temp;
+    }
+    pool.release(nodeToDelete);
+    list->size--;
+}
+
+/**
+ * Najde první výskyt hodnoty value v seznamu a vrátí jeho index (0-based), jinak -1.
+ */
+int findFirstOccurrence(const IndexLinkedList *list, int value)
+{
+    const IndexNodePool &pool = *list->pool;
+    int index = 0;
+    for (uint32_t node = list->head; node != NO_NODE; node = pool[node].next)
+    {
+        if (pool[node].data == value)
+        {
+            return index;
+        }
+        index++;
+    }
+    return -1;
+}
+
+/**
+ * Setříděný řetězec uzlů v IndexNodePool (obdoba Run).
+ */
+struct IndexRun
+{
+    uint32_t head;
+    uint32_t tail;
+};
+
+/**
+ * Stabilní slití dvou setříděných řetězců přepojením indexů (jako mergeRuns nad Node).
+ */
+static IndexRun mergeRuns(IndexNodePool &pool, IndexRun left, IndexRun right)
+{
+    if (left.head == NO_NODE)
+    {
+        return right;
+    }
+    if (right.head == NO_NODE)
+    {
+        return left;
+    }
+    uint32_t l = left.head;
+    uint32_t r = right.head;
+    // Místo pomocného uzlu určíme první uzel výsledku předem
+    uint32_t head;
+    if (pool[r].data < pool[l].data)
+    {
+        head = r;
+        r = pool[r].next;
+    }
+    else
+    {
+        head = l;
+        l = pool[l].next;
+    }
+    uint32_t last = head;
+    while (l != NO_NODE && r != NO_NODE)
+    {
+        if (pool[r].data < pool[l].data)
+        {
+            pool[last].next = r;
+            last = r;
+            r = pool[r].next;
+        }
+        else
+        {
+            pool[last].next = l;
+            last = l;
+            l = pool[l].next;
+        }
+    }
+    if (l != NO_NODE)
+    {
+        pool[last].next = l;
+        return {head, left.tail};
+    }
+    pool[last].next = r;
+    return {head, r != NO_NODE ? right.tail : last};
+}
+
+/**
+ * Odpojí ze začátku *rest nejdelší setříděný běh (klesající běh otočí), jako takeRun nad Node.
+ */
+static IndexRun takeRun(IndexNodePool &pool, uint32_t *rest)
+{
+    uint32_t first = *rest;
+    uint32_t last = first;
+    uint32_t next = pool[first].next;
+    if (next != NO_NODE && pool[next].data < pool[first].data)
+    {
+        // Klesající běh: otáčíme ho za běhu
+        uint32_t reversed = first;
+        uint32_t node = next;
+        pool[first].next = NO_NODE;
+        while (node != NO_NODE && pool[node].data < pool[reversed].data)
+        {
+            next = pool[node].next;
+            pool[node].next = reversed;
+            reversed = node;
+            node = next;
+        }
+        *rest = node;
+        return {reversed, first};
+    }
+    while (pool[last].next != NO_NODE && !(pool[pool[last].next].data < pool[last].data))
+    {
+        last = pool[last].next;
+    }
+    *rest = pool[last].next;
+    pool[last].next = NO_NODE;
+    return {first, last};
+}
+
+/**
+ * Přirozený merge sort zdola nahoru (stejný postup jako mergeSort nad Node).
+ */
+static IndexRun mergeSort(IndexNodePool &pool, uint32_t head)
+{
+    IndexRun buckets[64];
+    std::fill(std::begin(buckets), std::end(buckets), IndexRun{NO_NODE, NO_NODE});
+    uint32_t rest = head;
+    while (rest != NO_NODE)
+    {
+        IndexRun run = takeRun(pool, &rest);
+        int i = 0;
+        for (; buckets[i].head != NO_NODE; i++)
+        {
+            run = mergeRuns(pool, buckets[i], run);
+            buckets[i] = IndexRun{NO_NODE, NO_NODE};
+        }
+        buckets[i] = run;
+    }
+
+    IndexRun result = {NO_NODE, NO_NODE};
+    for (const IndexRun &bucket : buckets)
+    {
+        result = mergeRuns(pool, bucket, result);
+    }
+    return result;
+}
+
+/**
+ * Setřídí seznam vzestupně (stabilně, bez alokace) a aktualizuje poslední uzel.
+ */
+void sortList(IndexLinkedList *list)
+{
+    IndexRun sorted = mergeSort(*list->pool, list->head);
+    list->head = sorted.head;
+    list->tail = sorted.tail;
+}
+
+/**
+ * Vrátí všechny uzly seznamu do poolu v O(1) a nechá seznam prázdný.
+ */
+void deleteList(IndexLinkedList *list)
+{
+    list->pool->releaseChain(list->head, list->tail);
+    list->head = list->tail = NO_NODE;
+    list->size = 0;
+}
+
+/**
+ * Tisk seznamu stejně jako u Node* ("data data data").
+ */
+std::ostream &operator<<(std::ostream &os, const IndexLinkedList &list)
+{
+    const IndexNodePool &pool = *list.pool;
+    for (uint32_t node = list.head; node != NO_NODE; node = pool[node].next)
+    {
+        os << pool[node].data;
+        if (pool[node].next != NO_NODE)
+        {
+            os << " ";
+        }
+    }
+    return os;
+}
+
+/**
+ * Blok rozbaleného seznamu (unrolled linked list): místo jedné hodnoty na uzel
+ * drží pole až CAPACITY hodnot. Blok má přesně dvě cache line (128 B), průchod
+ * tak čte souvislou paměť a ukazatel next se sleduje jen jednou za blok.
+ */
+struct alignas(64) UnrolledBlock
+{
+    static constexpr int CAPACITY = 28;
+
+    int data[CAPACITY];
+    int count;
+    UnrolledBlock *next;
+};
+
+static_assert(sizeof(UnrolledBlock) == 128, "UnrolledBlock má zabírat dvě cache line");
+
+/**
+ * Rozbalený seznam se stejnými operacemi jako LinkedList. Všechny bloky kromě
+ * prázdného seznamu mají alespoň jeden prvek; při mazání se málo zaplněné bloky
+ * slévají se sousedem, při vkládání do plného bloku se blok rozdělí.
+ */
+struct UnrolledList
+{
+    UnrolledBlock *head = nullptr;
+    UnrolledBlock *tail = nullptr;
+    size_t size = 0;
+};
+
+static UnrolledBlock *createBlock()
+{
+    UnrolledBlock *block = new UnrolledBlock;
+    block->count = 0;
+    block->next = nullptr;
+    return block;
+}
+
+// Vloží hodnotu do bloku (který není plný) na pozici pos
+static void insertIntoBlock(UnrolledBlock *block, int pos, int data)
+{
+    std::copy_backward(block->data + pos, block->data + block->count, block->data + block->count + 1);
+    block->data[pos] = data;
+    block->count++;
+}
+
+/**
+ * Rozdělí plný blok na dva poloviční, nový blok je hned za ním.
+ */
+static void splitBlock(UnrolledList *list, UnrolledBlock *block)
+{
+    UnrolledBlock *newBlock = createBlock();
+    int half = block->count / 2;
+    std::copy(block->data + half, block->data + block->count, newBlock->data);
+    newBlock->count = block->count - half;
+    block->count = half;
+    newBlock->next = block->next;
+    block->next = newBlock;
+    if (list->tail == block)
+    {
+        list->tail = newBlock;
+    }
+}
+
+/**
+ * Po smazání prvku z bloku: prázdný blok odpojí, málo zaplněný blok slije
+ * s následujícím (vejdou-li se do jednoho), nebo si od něj část prvků přesune.
+ * @param prev Blok před block (nullptr, pokud je block první)
+ */
+static void rebalanceBlock(UnrolledList *list, UnrolledBlock *prev, UnrolledBlock *block)
+{
+    if (block->count == 0)
+    {
+        (prev != nullptr ? prev->next : list->head) = block->next;
+        if (list->tail == block)
+        {
+            list->tail = prev;
+        }
+        delete block;
+        return;
+    }
+
+    UnrolledBlock *next = block->next;
+    if (block->count >= UnrolledBlock::CAPACITY / 2 || next == nullptr)
+    {
+        return;
+    }
+    if (block->count + next->count <= UnrolledBlock::CAPACITY)
+    {
+        // Slití s následujícím blokem
+        std::copy(next->data, next->data + next->count, block->data + block->count);
+        block->count += next->count;
+        block->next = next->next;
+        if (list->tail == next)
+        {
+            list->tail = block;
+        }
+        delete next;
+        return;
+    }
+    // Vyrovnání: přesuneme část prvků ze začátku následujícího bloku
+    int move = (next->count - block->count) / 2;
+    std::copy(next->data, next->data + move, block->data + block->count);
+    std::copy(next->data + move, next->data + next->count, next->data);
+    block->count += move;
+    next->count -= move;
+}
+
+/**
+ * Vloží hodnotu na začátek seznamu. Je-li první blok plný, přidá se nový blok,
+ * opakované vkládání na začátek tak plní bloky celé.
+ */
+void insertAtBeginning(UnrolledList *list, int data)
+{
+    if (list->head == nullptr || list->head->count == UnrolledBlock::CAPACITY)
+    {
+        UnrolledBlock *block = createBlock();
+        block->next = list->head;
+        list->head = block;
+        if (list->tail == nullptr)
+        {
+            list->tail = block;
+        }
+    }
+    insertIntoBlock(list->head, 0, data);
+    list->size++;
+}
+
+/**
+ * Vloží hodnotu na konec seznamu v O(1).
+ */
+void insertAtEnd(UnrolledList *list, const int data)
+{
+    if (list->tail == nullptr || list->tail->count == UnrolledBlock::CAPACITY)
+    {
+        UnrolledBlock *block = createBlock();
+        (list->tail != nullptr ? list->tail->next : list->head) = block;
+        list->tail = block;
+    }
+    list->tail->data[list->tail->count++] = data;
+    list->size++;
+}
+
+/**
+ * Vloží hodnotu na zadaný index (index <= 0 -> na začátek, za koncem -> na konec).
+ * Hledání pozice přeskakuje celé bloky.
+ */
+void insertAtIndex(UnrolledList *list, int data, int index)
+{
+    if (index <= 0)
+    {
+        insertAtBeginning(list, data);
+        return;
+    }
+    if (static_cast<size_t>(index) >= list->size)
+    {
+        insertAtEnd(list, data);
+        return;
+    }
+
+    UnrolledBlock *block = list->head;
+    int pos = index;
+    while (pos > block->count)
+    {
+        pos -= block->count;
+        block = block->next;
+    }
+    if (block->count == UnrolledBlock::CAPACITY)
+    {
+        splitBlock(list, block);
+        if (pos > block->count)
+        {
+            pos -= block->count;
+            block = block->next;
+        }
+    }
+    insertIntoBlock(block, pos, data);
+    list->size++;
+}
+
+/**
+ * Smaže prvek na zadaném indexu (pokud existuje), index 0 = první prvek.
+ */
+void deleteAtIndex(UnrolledList *list, int index)
+{
+    if (index < 0 || static_cast<size_t>(index) >= list->size)
+    {
+        return; // index mimo rozsah seznamu
+    }
+
+    UnrolledBlock *prev = nullptr;
+    UnrolledBlock *block = list->head;
+    int pos = index;
+    while (pos >= block->count)
+    {
+        pos -= block->count;
+        prev = block;
+        block = block->next;
+    }
+    std::copy(block->data + pos + 1, block->data + block->count, block->data + pos);
+    block->count--;
+    list->size--;
+    rebalanceBlock(list, prev, block);
+}
+
+void deleteAtBeginning(UnrolledList *list)
+{
+    deleteAtIndex(list, 0);
+}
+
+/**
+ * Smaže poslední prvek. Dokud v posledním bloku zbývá víc prvků, je to O(1);
+ * při vyprázdnění bloku se hledá předchozí blok.
+ */
+void deleteAtEnd(UnrolledList *list)
+{
+    if (list->tail == nullptr)
+    {
+        return; // seznam je prázdný
+    }
+    if (list->tail->count > 1)
+    {
+        list->tail->count--;
+        list->size--;
+        return;
+    }
+    deleteAtIndex(list, static_cast<int>(list->size - 1));
+}
+
+/**
+ * Index hodnoty v bloku, nebo -1. S SSE2 porovnává čtyři hodnoty najednou
+ * (data bloku jsou zarovnaná na 64 B, čtení je tedy zarovnané).
+ */
+static int findInBlock(const UnrolledBlock *block, int value)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i needle = _mm_set1_epi32(value);
+    for (; i + 4 <= block->count; i += 4)
+    {
+        __m128i values = _mm_load_si128(reinterpret_cast<const __m128i *>(block->data + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, needle)));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(static_cast<unsigned int>(mask));
+        }
+    }
+#endif
+    for (; i < block->count; i++)
+    {
+        if (block->data[i] == value)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Najde první výskyt hodnoty value v seznamu a vrátí jeho index (0-based), jinak -1.
+ */
+int findFirstOccurrence(const UnrolledList *list, int value)
+{
+    int base = 0;
+    for (const UnrolledBlock *block = list->head; block != nullptr; block = block->next)
+    {
+        int pos = findInBlock(block, value);
+        if (pos >= 0)
+        {
+            return base + pos;
+        }
+        base += block->count;
+    }
+    return -1;
+}
+
+/**
+ * Setřídí seznam vzestupně. Hodnoty se zkopírují do pole, setřídí a zapíšou
+ * zpět do stejných bloků (rozdělení do bloků se nemění).
+ */
+void sortList(UnrolledList *list)
+{
+    std::vector<int> values;
+    values.reserve(list->size);
+    for (const UnrolledBlock *block = list->head; block != nullptr; block = block->next)
+    {
+        values.insert(values.end(), block->data, block->data + block->count);
+    }
+    std::sort(values.begin(), values.end());
+    const int *next = values.data();
+    for (UnrolledBlock *block = list->head; block != nullptr; block = block->next)
+    {
+        std::copy(next, next + block->count, block->data);
+        next += block->count;
+    }
+}
+
+/**
+ * Smaže (dealokuje) celý seznam a nechá ho prázdný.
+ */
+void deleteList(UnrolledList *list)
+{
+    while (list->head != nullptr)
+    {
+        UnrolledBlock *block = list->head;
+        list->head = block->next;
+        delete block;
+    }
+    list->tail = nullptr;
+    list->size = 0;
+}
+
+/**
+ * Tisk seznamu ve stejném formátu jako u Node* ("data data data").
+ */
+std::ostream &operator<<(std::ostream &os, const UnrolledList &list)
+{
+    bool first = true;
+    for (const UnrolledBlock *block = list.head; block != nullptr; block = block->next)
+    {
+        for (int i = 0; i < block->count; i++)
+        {
+            if (!first)
+            {
+                os << " ";
+            }
+            os << block->data[i];
+            first = false;
+        }
+    }
+    return os;
+}
+
+#ifndef __TEST__
+int main()
+{
+    // Vytvoření seznamu
+    Node *head = nullptr;
+    insertAtBeginning(&head, 1);
+    insertAtBeginning(&head, 2);
+    insertAtEnd(&head, 3);
+    insertAtEnd(&head, 4);
+    insertAtIndex(&head, 5, 2);
+
+    std::cout << "Seznam po vložení prvků: " << head << std::endl;
+    std::cout << "První výskyt hodnoty 3 je na indexu: " << findFirstOccurrence(head, 3) << std::endl;
+
+    std::cout << "Seznam před tříděním: " << head << std::endl;
+    sortList(&head);
+    std::cout << "Seznam po třídění: " << head << std::endl;
+
+    deleteAtBeginning(&head);
+    deleteAtEnd(&head);
+    std::cout << "Seznam po smazání prvků: " << head << std::endl;
+
+    deleteAtIndex(head, 1);
+    std::cout << "Seznam po smazání prvků: " << head << std::endl;
+
+    deleteList(&head);
+
+    // Seznam s ukazatelem na konec: vložení na konec je O(1)
+    LinkedList list;
+    for (int i = 0; i < 10; i++)
+    {
+        insertAtEnd(&list, i);
+    }
+    deleteAtIndex(&list, 0);
+    std::cout << "Seznam s " << list.size << " prvky: " << list << std::endl;
+    deleteList(&list);
+
+    // Uzly z poolu: jedna alokace na celý slab, smazání seznamu v O(1)
+    NodePool pool;
+    LinkedList pooled;
+    pooled.pool = &pool;
+    for (int i = 0; i < 10000; i++)
+    {
+        insertAtEnd(&pooled, i);
+    }
+    std::cout << "Seznam v poolu: " << pooled.size << " prvku v " << pool.slabCount() << " slabech" << std::endl;
+    deleteList(&pooled);
+
+    // Rozbalený seznam: až 28 hodnot v jednom bloku
+    UnrolledList unrolled;
+    for (int i = 0; i < 100; i++)
+    {
+        insertAtEnd(&unrolled, 100 - i);
+    }
+    insertAtIndex(&unrolled, 0, 50);
+    sortList(&unrolled);
+    deleteAtBeginning(&unrolled);
+    std::cout << "Rozbaleny seznam: " << unrolled.size << " prvku, hodnota 42 je na indexu "
+              << findFirstOccurrence(&unrolled, 42) << std::endl;
+    deleteList(&unrolled);
 
     return 0;
 }
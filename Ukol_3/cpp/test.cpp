@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <sstream>
+#include <vector>
 #include "linked_list.cpp" // Předpokládám, že kód z otázky je v souboru linked_list.h
 
 TEST(LinkedListTest, InsertAtBeginning)
@@ -107,4 +109,434 @@ TEST(LinkedListTest, OperatorPrint)
     std::stringstream ss;
     ss << head;
     ASSERT_EQ("1 2 3", ss.str());
-}
\ No newline at end of file
+}
+
+// Ověří, že head, tail a size odpovídají skutečnému řetězci uzlů
+static void checkConsistency(const LinkedList &list)
+{
+    size_t count = 0;
+    Node *last = nullptr;
+    for (Node *node = list.head; node != nullptr; node = node->next)
+    {
+        last = node;
+        count++;
+    }
+    ASSERT_EQ(list.size, count);
+    ASSERT_EQ(list.tail, last);
+}
+
+TEST(LinkedListTest, ListHandleOperations)
+{
+    LinkedList list;
+    insertAtEnd(&list, 2);
+    insertAtBeginning(&list, 1);
+    insertAtEnd(&list, 4);
+    insertAtIndex(&list, 3, 2);
+    insertAtIndex(&list, 5, 100); // za koncem -> na konec
+    insertAtIndex(&list, 0, -1);  // záporný index -> na začátek
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+    std::stringstream ss;
+    ss << list;
+    ASSERT_EQ("0 1 2 3 4 5", ss.str());
+    ASSERT_EQ(3, findFirstOccurrence(&list, 3));
+
+    deleteAtIndex(&list, 0); // na rozdíl od verze s Node* smaže i první uzel
+    deleteAtIndex(&list, 4); // poslední uzel -> změní tail
+    deleteAtIndex(&list, 10);
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+    ASSERT_EQ(4, list.tail->data);
+    deleteAtEnd(&list);
+    deleteAtBeginning(&list);
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+    ss.str("");
+    ss << list;
+    ASSERT_EQ("2 3", ss.str());
+
+    insertAtBeginning(&list, 9);
+    sortList(&list);
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+    ASSERT_EQ(9, list.tail->data);
+
+    deleteAtEnd(&list);
+    deleteAtEnd(&list);
+    deleteAtEnd(&list);
+    deleteAtEnd(&list); // prázdný seznam
+    deleteAtBeginning(&list);
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+    ASSERT_EQ(nullptr, list.head);
+
+    insertAtEnd(&list, 7);
+    deleteList(&list);
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+}
+
+TEST(LinkedListTest, ListHandleLargeAppend)
+{
+    // Vložení na konec je O(1), milion prvků tedy trvá zlomek sekundy
+    LinkedList list;
+    const int count = 1000000;
+    for (int i = 0; i < count; i++)
+    {
+        insertAtEnd(&list, i);
+    }
+    ASSERT_EQ(static_cast<size_t>(count), list.size);
+    ASSERT_EQ(count - 1, list.tail->data);
+    ASSERT_EQ(count - 1, findFirstOccurrence(&list, count - 1));
+    deleteList(&list);
+    ASSERT_EQ(0u, list.size);
+}
+
+TEST(LinkedListTest, NodePool)
+{
+    NodePool pool;
+    LinkedList list;
+    list.pool = &pool;
+    for (int i = 0; i < 10000; i++)
+    {
+        insertAtEnd(&list, i);
+    }
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+    ASSERT_EQ(3u, pool.slabCount()); // 10000 uzlů po 4096 ve slabu
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(list.head) % NodePool::CACHE_LINE);
+    ASSERT_EQ(list.head + 1, list.head->next); // uzly leží v paměti za sebou
+    ASSERT_EQ(9999, findFirstOccurrence(&list, 9999));
+
+    // Uvolněný uzel se znovu použije
+    Node *second = list.head->next;
+    deleteAtIndex(&list, 1);
+    insertAtBeginning(&list, -1);
+    ASSERT_EQ(second, list.head);
+    insertAtIndex(&list, 5, 3);
+    deleteAtEnd(&list);
+    deleteAtBeginning(&list);
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+
+    // Smazání seznamu vrátí uzly do poolu, nové uzly se berou z nich
+    deleteList(&list);
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+    for (int i = 0; i < 10000; i++)
+    {
+        insertAtEnd(&list, i);
+    }
+    ASSERT_EQ(3u, pool.slabCount());
+    deleteAtIndex(&list, 0);
+    sortList(&list);
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+
+    // Hromadné uvolnění celého poolu
+    releasePool(&list);
+    ASSERT_EQ(0u, pool.slabCount());
+    ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+    insertAtEnd(&list, 1);
+    insertAtEnd(&list, 2);
+    std::stringstream ss;
+    ss << list;
+    ASSERT_EQ("1 2", ss.str());
+    deleteList(&list);
+}
+
+TEST(LinkedListTest, IndexLinkedList)
+{
+    ASSERT_EQ(8u, sizeof(IndexNode));
+    IndexNodePool pool;
+    IndexLinkedList list{&pool};
+    insertAtEnd(&list, 2);
+    insertAtEnd(&list, 3);
+    insertAtBeginning(&list, 1);
+    ASSERT_EQ(3u, list.size);
+    ASSERT_EQ(2, findFirstOccurrence(&list, 3));
+    ASSERT_EQ(-1, findFirstOccurrence(&list, 4));
+    std::stringstream ss;
+    ss << list;
+    ASSERT_EQ("1 2 3", ss.str());
+
+    uint32_t first = list.head;
+    deleteAtBeginning(&list);
+    insertAtEnd(&list, 4); // použije uvolněný uzel
+    ASSERT_EQ(first, list.tail);
+    ss.str("");
+    ss << list;
+    ASSERT_EQ("2 3 4", ss.str());
+
+    // Druhý seznam ve stejném poolu
+    IndexLinkedList other{&pool};
+    insertAtEnd(&other, 10);
+    deleteList(&list);
+    ASSERT_EQ(0u, list.size);
+    ASSERT_EQ(NO_NODE, list.head);
+    ASSERT_EQ(0, findFirstOccurrence(&other, 10));
+    deleteAtBeginning(&other);
+    deleteAtBeginning(&other);
+    ASSERT_EQ(NO_NODE, other.tail);
+    pool.releaseAll();
+}
+
+// Hodnoty seznamu nad IndexNodePool; ověří i tail a size
+static std::vector<int> indexListValues(const IndexLinkedList &list)
+{
+    std::vector<int> values;
+    uint32_t last = NO_NODE;
+    for (uint32_t node = list.head; node != NO_NODE; node = (*list.pool)[node].next)
+    {
+        values.push_back((*list.pool)[node].data);
+        last = node;
+    }
+    EXPECT_EQ(list.tail, last);
+    EXPECT_EQ(list.size, values.size());
+    return values;
+}
+
+TEST(LinkedListTest, IndexLinkedListAllOperations)
+{
+    IndexNodePool pool;
+    IndexLinkedList list{&pool};
+    insertAtIndex(&list, 2, 5); // prázdný seznam -> na konec
+    insertAtIndex(&list, 0, 0);
+    insertAtIndex(&list, 1, 1);
+    insertAtIndex(&list, 3, 3);
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3}), indexListValues(list));
+    deleteAtIndex(&list, 1);
+    deleteAtIndex(&list, 2); // poslední uzel
+    deleteAtIndex(&list, 7);
+    ASSERT_EQ((std::vector<int>{0, 2}), indexListValues(list));
+    deleteAtEnd(&list);
+    deleteAtEnd(&list);
+    deleteAtEnd(&list);
+    ASSERT_TRUE(indexListValues(list).empty());
+
+    // Třídění: běhy vzestupné i klesající, duplicity; výsledek je setříděný a tail sedí
+    std::vector<int> expected;
+    for (int i = 0; i < 5000; i++)
+    {
+        int value = (i * 7919) % 1000 - (i % 3 == 0 ? i : 0);
+        insertAtEnd(&list, value);
+        expected.push_back(value);
+    }
+    sortList(&list);
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, indexListValues(list));
+    insertAtEnd(&list, 5000); // po třídění se připojuje za správný uzel
+    expected.push_back(5000);
+    ASSERT_EQ(expected, indexListValues(list));
+
+    IndexLinkedList empty{&pool};
+    sortList(&empty);
+    ASSERT_TRUE(indexListValues(empty).empty());
+    deleteList(&list);
+}
+
+// Seznam z hodnot (bez ukazatele na konec, pro funkce nad Node**)
+static Node *buildList(const std::vector<int> &values)
+{
+    LinkedList list;
+    for (int value : values)
+    {
+        insertAtEnd(&list, value);
+    }
+    return list.head;
+}
+
+static std::vector<int> listValues(Node *head)
+{
+    std::vector<int> values;
+    for (; head != nullptr; head = head->next)
+    {
+        values.push_back(head->data);
+    }
+    return values;
+}
+
+TEST(LinkedListTest, SortListMergeSort)
+{
+    // Prázdný seznam, jeden prvek, setříděný, obráceně setříděný, skoro setříděný, náhodný
+    std::vector<std::vector<int>> cases = {{}, {5}, {1, 2, 3, 4}, {4, 3, 2, 1}, {1, 2, 4, 3, 5, 6, 8, 7}, {3, 3, 1, 2, 1, 3}};
+    std::vector<int> random;
+    unsigned int state = 12345;
+    for (int i = 0; i < 5000; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        random.push_back(static_cast<int>((state >> 16) % 100) - 50);
+    }
+    cases.push_back(random);
+
+    for (const std::vector<int> &values : cases)
+    {
+        Node *head = buildList(values);
+        sortList(&head);
+        std::vector<int> expected = values;
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(expected, listValues(head));
+        deleteList(&head);
+    }
+}
+
+TEST(LinkedListTest, SortListStableAndRelinks)
+{
+    // Třídění přepojuje uzly: uzly se stejnou hodnotou musí zůstat v původním pořadí
+    Node *head = buildList({2, 1, 2, 1, 2, 1, 1, 2});
+    std::vector<Node *> ones, twos;
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        (node->data == 1 ? ones : twos).push_back(node);
+    }
+    sortList(&head);
+    std::vector<Node *> sorted;
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        sorted.push_back(node);
+    }
+    std::vector<Node *> expected = ones;
+    expected.insert(expected.end(), twos.begin(), twos.end());
+    ASSERT_EQ(expected, sorted);
+    deleteList(&head);
+}
+
+TEST(LinkedListTest, SortListParallel)
+{
+    std::vector<int> values;
+    unsigned int state = 7;
+    for (int i = 0; i < 300000; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        values.push_back(static_cast<int>(state >> 8));
+    }
+    std::vector<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    for (unsigned int threads : {1u, 2u, 3u, 4u})
+    {
+        LinkedList list;
+        for (int value : values)
+        {
+            insertAtEnd(&list, value);
+        }
+        sortListParallel(&list, threads);
+        ASSERT_NO_FATAL_FAILURE(checkConsistency(list));
+        ASSERT_EQ(expected, listValues(list.head));
+        deleteList(&list);
+    }
+
+    // Malý seznam se třídí v jednom vlákně
+    Node *head = buildList({3, 1, 2});
+    sortListParallel(&head, 8);
+    ASSERT_EQ((std::vector<int>{1, 2, 3}), listValues(head));
+    deleteList(&head);
+}
+
+// Ověří invarianty rozbaleného seznamu a vrátí jeho hodnoty
+static std::vector<int> unrolledValues(const UnrolledList &list)
+{
+    std::vector<int> values;
+    const UnrolledBlock *last = nullptr;
+    for (const UnrolledBlock *block = list.head; block != nullptr; block = block->next)
+    {
+        EXPECT_GT(block->count, 0);
+        EXPECT_LE(block->count, UnrolledBlock::CAPACITY);
+        values.insert(values.end(), block->data, block->data + block->count);
+        last = block;
+    }
+    EXPECT_EQ(list.tail, last);
+    EXPECT_EQ(list.size, values.size());
+    return values;
+}
+
+TEST(LinkedListTest, UnrolledListOperations)
+{
+    UnrolledList list;
+    insertAtEnd(&list, 2);
+    insertAtBeginning(&list, 1);
+    insertAtEnd(&list, 4);
+    insertAtIndex(&list, 3, 2);
+    insertAtIndex(&list, 5, 100);
+    insertAtIndex(&list, 0, -1);
+    std::stringstream ss;
+    ss << list;
+    ASSERT_EQ("0 1 2 3 4 5", ss.str());
+    ASSERT_EQ(3, findFirstOccurrence(&list, 3));
+    ASSERT_EQ(-1, findFirstOccurrence(&list, 6));
+
+    deleteAtIndex(&list, 0);
+    deleteAtEnd(&list);
+    deleteAtBeginning(&list);
+    deleteAtIndex(&list, 10);
+    ASSERT_EQ((std::vector<int>{2, 3, 4}), unrolledValues(list));
+
+    deleteList(&list);
+    ASSERT_TRUE(unrolledValues(list).empty());
+    deleteAtEnd(&list);
+    deleteAtBeginning(&list);
+    ss.str("");
+    ss << list;
+    ASSERT_EQ("", ss.str());
+}
+
+TEST(LinkedListTest, UnrolledListMatchesVector)
+{
+    // Náhodné operace porovnané s std::vector; bloky se dělí i slévají
+    UnrolledList list;
+    std::vector<int> expected;
+    unsigned int state = 99;
+    auto random = [&state](unsigned int limit) {
+        state = state * 1103515245u + 12345u;
+        return static_cast<int>((state >> 8) % limit);
+    };
+    for (int step = 0; step < 20000; step++)
+    {
+        int value = random(1000);
+        int index = random(static_cast<unsigned int>(expected.size()) + 2);
+        switch (random(step < 10000 ? 6 : 8)) // ve druhé půlce víc mazání
+        {
+        case 0:
+            insertAtBeginning(&list, value);
+            expected.insert(expected.begin(), value);
+            break;
+        case 1:
+            insertAtEnd(&list, value);
+            expected.push_back(value);
+            break;
+        case 2:
+        case 3:
+            insertAtIndex(&list, value, index);
+            expected.insert(expected.begin() + std::min<size_t>(index, expected.size()), value);
+            break;
+        case 4:
+            deleteAtBeginning(&list);
+            if (!expected.empty())
+            {
+                expected.erase(expected.begin());
+            }
+            break;
+        case 5:
+            deleteAtEnd(&list);
+            if (!expected.empty())
+            {
+                expected.pop_back();
+            }
+            break;
+        default:
+            deleteAtIndex(&list, index);
+            if (static_cast<size_t>(index) < expected.size())
+            {
+                expected.erase(expected.begin() + index);
+            }
+            break;
+        }
+        if (step % 1000 == 0)
+        {
+            ASSERT_EQ(expected, unrolledValues(list));
+        }
+    }
+    ASSERT_EQ(expected, unrolledValues(list));
+
+    // Vyhledávání (vektorově uvnitř bloků) a třídění
+    for (int value = 0; value < 1000; value += 37)
+    {
+        auto it = std::find(expected.begin(), expected.end(), value);
+        int expectedIndex = it == expected.end() ? -1 : static_cast<int>(it - expected.begin());
+        ASSERT_EQ(expectedIndex, findFirstOccurrence(&list, value));
+    }
+    sortList(&list);
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, unrolledValues(list));
+    deleteList(&list);
+}